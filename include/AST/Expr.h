@@ -132,10 +132,13 @@ struct ScopeResol : Named {
   }
 };
 
+//
+// [a, b, ...]
+// (a, b, ...)  as ASTKind::Tuple
 struct Array : Base {
   ASTVector elements;
 
-  TypeInfo elem_type; // set in Sema
+  TypeInfo elem_type; // set in Sema (Tuple: type of the tuple)
 
   static ASTPtr<Array> New(Token tok);
 
@@ -144,6 +147,21 @@ struct Array : Base {
   Array(Token tok);
 };
 
+//
+// {key: value, ...}
+struct Dict : Base {
+  ASTVector keys;
+  ASTVector values;
+
+  TypeInfo type; // set in Sema
+
+  static ASTPtr<Dict> New(Token tok);
+
+  ASTPointer Clone() const override;
+
+  Dict(Token tok);
+};
+
 struct CallFunc : Base {
   ASTPointer callee; // left side, evaluated to be callable object.
   ASTVector args;
@@ -151,6 +169,9 @@ struct CallFunc : Base {
   ASTPtr<Function> callee_ast = nullptr;
   builtins::Function const* callee_builtin = nullptr;
 
+  // compiled format string literal of format() or printf()
+  std::shared_ptr<builtins::FormatString> format = nullptr;
+
   bool call_functor = false;
 
   ASTPtr<Enum> ast_enum = nullptr;
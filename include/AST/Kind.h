@@ -38,6 +38,8 @@ enum class ASTKind {
   OverloadResolutionGuide, // "of"
 
   Array,
+  Dict,
+  Tuple, // => AST::Array
 
   IndexRef,
 
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <memory>
+
+#include "types.h"
+
+//
+// B+tree for ordered_map.
+//
+//  every node stores its keys in a contiguous array, together with
+//  a 64-bit prefix of each key which is ordered same as the key.
+//  (int, float, char: the value itself / string: first 4 code units)
+//  so most of comparisons are done in the node, without reading objects.
+//
+//  entries are stored in leaves, and leaves are linked in order of keys.
+//
+namespace fire::btree {
+
+class BTree {
+  static constexpr size_t max_keys = 32;
+  static constexpr size_t min_keys = max_keys / 3;
+
+  struct Key {
+    u64 prefix;
+    Object const* obj;
+  };
+
+  struct Node {
+    bool leaf;
+    size_t count = 0;
+
+    // +1 for overflow before split
+    u64 prefix[max_keys + 1];
+    ObjPointer keys[max_keys + 1];
+
+    Node(bool leaf)
+        : leaf(leaf) {
+    }
+
+    virtual ~Node() = default;
+  };
+
+  struct Leaf : Node {
+    ObjPointer values[max_keys + 1];
+    Leaf* next = nullptr;
+
+    Leaf()
+        : Node(true) {
+    }
+  };
+
+  struct Inner : Node {
+    std::unique_ptr<Node> children[max_keys + 2];
+
+    Inner()
+        : Node(false) {
+    }
+  };
+
+public:
+  //
+  // position of entry.
+  //   leaf == nullptr if end.
+  struct Cursor {
+    Leaf const* leaf = nullptr;
+    size_t index = 0;
+
+    bool IsEnd() const {
+      return !this->leaf;
+    }
+
+    ObjPointer const& GetKey() const {
+      return this->leaf->keys[this->index];
+    }
+
+    ObjPointer const& GetValue() const {
+      return this->leaf->values[this->index];
+    }
+
+    void Next();
+  };
+
+  //
+  // key_kind: Int, Float, Char or String
+  BTree(TypeKind key_kind);
+
+  // deep copy
+  BTree(BTree const& other);
+
+  size_t Count() const {
+    return this->count;
+  }
+
+  ObjPointer const* Find(ObjPointer const& key) const;
+
+  //
+  // get value to assign.
+  //   if not found, key is inserted with none.
+  ObjPointer& GetOrInsert(ObjPointer const& key);
+
+  bool Remove(ObjPointer const& key);
+
+  void Clear();
+
+  Cursor Begin() const;
+  Cursor Last() const;
+
+  // first entry which key >= key
+  Cursor LowerBound(ObjPointer const& key) const;
+
+  // first entry which key > key
+  Cursor UpperBound(ObjPointer const& key) const;
+
+  // compare two keys (< 0, 0, > 0)
+  int Compare(ObjPointer const& a, ObjPointer const& b) const;
+
+  //
+  // types which can be used as key.
+  static bool IsOrderedType(TypeKind kind);
+
+private:
+  TypeKind key_kind;
+
+  //
+  // new node made by split, and first key of it.
+  struct Split {
+    u64 prefix;
+    ObjPointer key;
+    std::unique_ptr<Node> node;
+  };
+
+  std::unique_ptr<Node> root;
+
+  size_t count = 0;
+
+  Key make_key(ObjPointer const& obj) const;
+
+  // compare key with keys[index] of node
+  int compare(Key const& key, Node const* node, size_t index) const;
+
+  size_t lower_index(Node const* node, Key const& key) const;
+  size_t upper_index(Node const* node, Key const& key) const;
+
+  Cursor bound(ObjPointer const& key, bool upper) const;
+
+  ObjPointer* insert(Node* node, Key const& key, ObjPointer const& key_obj, Split& split);
+
+  bool remove(Node* node, Key const& key);
+
+  void fix_child(Inner* parent, size_t index);
+
+  static std::unique_ptr<Node> copy_node(Node const* node, Leaf*& prev_leaf);
+};
+
+} // namespace fire::btree
@@ -8,6 +8,11 @@ namespace fire::builtins {
 struct Function {
   using FuncPointer = ObjPointer (*)(ASTPtr<AST::CallFunc>, ObjVector);
 
+  //
+  // called in semantics analysis, when a call-expr is decided to call this.
+  //   (for checking or precompiling arguments)
+  using PreparePointer = void (*)(ASTPtr<AST::CallFunc>, Vec<TypeInfo> const& arg_types);
+
   string name;
 
   TypeInfo result_type;
@@ -17,15 +22,19 @@ struct Function {
 
   FuncPointer func;
 
+  PreparePointer prepare;
+
   ObjPointer Call(ASTPtr<AST::CallFunc> ast, ObjVector args) const;
 
   Function(std::string const& name, FuncPointer fp, TypeInfo result_type,
-           Vec<TypeInfo> arg_types, bool is_vararg = false)
+           Vec<TypeInfo> arg_types, bool is_vararg = false,
+           PreparePointer prepare = nullptr)
       : name(name),
         result_type(result_type),
         arg_types(arg_types),
         is_variable_args(is_vararg),
-        func(fp) {
+        func(fp),
+        prepare(prepare) {
   }
 };
 
@@ -37,6 +37,7 @@ public:
   ObjPointer& eval_as_left(ASTPointer ast);
 
   ObjPointer& eval_index_ref(ObjPointer array, ObjPointer index);
+  double& eval_matrix_element(ObjPointer const& matrix, ASTPointer index);
 
   //
   ObjPointer& eval_member_ref(ObjPtr<ObjInstance> inst, ASTPtr<AST::Class> expected_class,
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "types.h"
+
+//
+// Format string for format() / printf()
+//
+//  "{}"          argument
+//  "{:x}"        int as hexadecimal
+//  "{:.3}"       float with precision
+//  "{:8}"        width (right aligned), "{:<8}" left aligned
+//  "{{" "}}"     brace
+//
+//  when format string is literal, it's compiled in semantics analysis.
+//
+namespace fire::builtins {
+
+struct FormatError {
+  string msg;
+  size_t pos;
+};
+
+struct FormatString {
+  struct Segment {
+    std::u16string literal; // text before the argument
+
+    bool has_arg = false; // false if this is last text
+
+    bool left_align = false;
+    bool hex = false;
+    int width = 0;
+    int precision = -1;
+  };
+
+  Vec<Segment> segments;
+
+  size_t arg_count = 0;
+
+  //
+  // throws FormatError if fmt is invalid.
+  static std::shared_ptr<FormatString> Compile(std::u16string_view fmt);
+
+  //
+  // args must have arg_count elements.
+  void Write(std::string& out, ObjPointer const* args) const;    // UTF-8
+  void Write(std::u16string& out, ObjPointer const* args) const; // UTF-16
+};
+
+} // namespace fire::builtins
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "types.h"
+
+//
+// Output streams of interpreter. (stdout, stderr)
+//
+//  written data is stored to buffer, and flushed when:
+//    - buffer is full
+//    - new line is written, if line-buffered (stdout is a terminal)
+//    - Flush() is called (flush() builtin, error, exit)
+//
+namespace fire::io {
+
+class OutputStream {
+public:
+  //
+  // append to this directly, and call Commit() after.
+  std::string& Buffer() {
+    return this->buf;
+  }
+
+  void Commit();
+
+  void Write(std::string_view str) {
+    this->buf.append(str);
+    this->Commit();
+  }
+
+  void Flush();
+
+  //
+  // 0 = not buffered
+  void SetBufferSize(size_t size);
+
+  OutputStream(int fd, size_t size, bool line_buffered);
+  ~OutputStream();
+
+private:
+  int fd;
+
+  std::string buf;
+
+  size_t capacity;
+
+  bool line_buffered;
+
+  size_t committed = 0; // length of buffer at last commit
+};
+
+OutputStream& out();
+OutputStream& err();
+
+//
+// whole content of file.
+//   size is taken from fstat, and read by one large read() if possible.
+//   returns false if cannot open or read.
+bool ReadFile(string const& path, Vec<u8>& out);
+
+// returns false if cannot open or write.
+bool WriteFile(string const& path, std::span<u8 const> data);
+
+//
+// read-only mapping of whole file. (mmap)
+//   files which cannot be mapped (pipe, /proc) are read into memory instead.
+//
+class MappedFile {
+public:
+  std::span<u8 const> View() const {
+    return {this->addr, this->size};
+  }
+
+  // nullptr if cannot open
+  static std::shared_ptr<MappedFile> Open(string const& path);
+
+  MappedFile(MappedFile const&) = delete;
+  ~MappedFile();
+
+private:
+  u8 const* addr = nullptr;
+  size_t size = 0;
+
+  bool mapped = false;
+
+  Vec<u8> data; // if not mapped
+
+  MappedFile() = default;
+};
+
+//
+// reads a file line by line, by large chunks.
+//   memory used is bounded by the chunk size. (or the longest line)
+//
+class LineReader {
+public:
+  //
+  // next line, without '\n'.
+  //   the view is valid until next call.
+  //   returns false at end of file.
+  bool Next(std::string_view& line);
+
+  bool AtEnd();
+
+  // nullptr if cannot open
+  static std::shared_ptr<LineReader> Open(string const& path);
+
+  LineReader(LineReader const&) = delete;
+  ~LineReader();
+
+private:
+  int fd;
+
+  Vec<char> buf;
+
+  size_t begin = 0; // unread data is [begin, end)
+  size_t end = 0;
+
+  bool eof = false;
+
+  // read more data after end. returns false if no more.
+  bool fill();
+
+  LineReader(int fd);
+};
+
+} // namespace fire::io
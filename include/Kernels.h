@@ -0,0 +1,83 @@
+#pragma once
+
+#include "types.h"
+
+//
+// Numeric kernels for unboxed vectors. (vector<int>, vector<float>)
+//
+//  T = i64 or double.
+//
+//  kernels are written with GCC vector extensions, and compiled twice:
+//  for SSE2 (baseline of x86-64) and for AVX2. one of them is selected
+//  at runtime by cpu features.
+//
+//  float reductions are accumulated in several lanes, so the order of
+//  additions is different from a simple loop.
+//
+namespace fire::kernels {
+
+template <typename T>
+T Sum(T const* a, size_t n);
+
+// n >= 1
+template <typename T>
+T Min(T const* a, size_t n);
+
+template <typename T>
+T Max(T const* a, size_t n);
+
+// index of first largest element (n >= 1)
+template <typename T>
+size_t ArgMax(T const* a, size_t n);
+
+template <typename T>
+T Dot(T const* a, T const* b, size_t n);
+
+//
+// elementwise:  out[i] = a[i] op b[i]
+//   out may be same as a or b.
+template <typename T>
+void Add(T const* a, T const* b, T* out, size_t n);
+
+template <typename T>
+void Sub(T const* a, T const* b, T* out, size_t n);
+
+template <typename T>
+void Mul(T const* a, T const* b, T* out, size_t n);
+
+// out[i] = a[i] * k
+template <typename T>
+void Scale(T const* a, T k, T* out, size_t n);
+
+// out[i] = min(max(a[i], lo), hi)
+template <typename T>
+void Clamp(T const* a, T lo, T hi, T* out, size_t n);
+
+// out[i] = a[0] + ... + a[i]
+template <typename T>
+void CumSum(T const* a, T* out, size_t n);
+
+//
+// matrix product (row-major):
+//   C[n x m] = A[n x k] * B[k x m]
+//
+//  C must not overlap with A or B.
+//  computed block by block, so that the blocks of A, B and C stay in cache.
+//
+void MatMul(double const* a, double const* b, double* c, size_t n, size_t k, size_t m);
+
+//
+// elementwise math of float:  out[i] = f(a[i])
+//
+//  polynomial approximations, error is within a few ulp.
+//  elements out of range of approximation (inf, nan, subnormal,
+//  very large argument of sin/cos, ...) are computed by libm.
+//
+//  out may be same as a.
+//
+void Exp(double const* a, double* out, size_t n);
+void Log(double const* a, double* out, size_t n);
+void Sin(double const* a, double* out, size_t n);
+void Cos(double const* a, double* out, size_t n);
+
+} // namespace fire::kernels
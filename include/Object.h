@@ -1,8 +1,11 @@
 #pragma once
 
+#include <cassert>
 #include <concepts>
 #include <string>
 #include <map>
+#include <span>
+#include <variant>
 
 #include "alert.h"
 #include "TypeInfo.h"
@@ -13,6 +16,18 @@ namespace builtins {
 struct Function;
 }
 
+namespace regex {
+class Regex;
+}
+
+namespace btree {
+class BTree;
+}
+
+namespace io {
+class LineReader;
+}
+
 struct Object {
   TypeInfo type;
   // i64 ref_count;
@@ -38,6 +53,10 @@ struct Object {
     return this->type.kind == TypeKind::Bool;
   }
 
+  bool is_fixed_int() const {
+    return this->type.is_fixed_int();
+  }
+
   bool is_char() const {
     return this->type.kind == TypeKind::Char;
   }
@@ -54,10 +73,42 @@ struct Object {
     return this->type.kind == TypeKind::String;
   }
 
+  bool is_string_builder() const {
+    return this->type.kind == TypeKind::StringBuilder;
+  }
+
   bool is_vector() const {
     return this->type.kind == TypeKind::Vector;
   }
 
+  bool is_dict() const {
+    return this->type.kind == TypeKind::Dict;
+  }
+
+  bool is_ordered_map() const {
+    return this->type.kind == TypeKind::OrderedMap;
+  }
+
+  bool is_set() const {
+    return this->type.kind == TypeKind::Set;
+  }
+
+  bool is_tuple() const {
+    return this->type.kind == TypeKind::Tuple;
+  }
+
+  bool is_deque() const {
+    return this->type.kind == TypeKind::Deque;
+  }
+
+  bool is_matrix() const {
+    return this->type.kind == TypeKind::Matrix;
+  }
+
+  bool is_bytes() const {
+    return this->type.kind == TypeKind::Bytes;
+  }
+
   i64 get_vi() const;
   double get_vf() const;
   char16_t get_vc() const;
@@ -95,6 +146,13 @@ struct Object {
     return this->ToString();
   }
 
+  //
+  // append ToString() result to out.
+  //   overridden by types which can write without temporary string.
+  virtual void AppendTo(string& out) const {
+    out += this->ToString();
+  }
+
 protected:
   Object(TypeInfo type);
 };
@@ -131,6 +189,7 @@ struct ObjPrimitive : Object {
 
   ObjPointer Clone() const override;
   string ToString() const override;
+  void AppendTo(string& out) const override;
 
   bool Equals(ObjPointer obj) const override {
     if (!this->type.equals(obj->type))
@@ -147,7 +206,7 @@ struct ObjPrimitive : Object {
       return this->vc == obj->get_vc();
     }
 
-    return this->vi == obj->get_vi();
+    return this->vi == obj->as_primitive()->vi;
   }
 
   ObjPrimitive(i64 vi = 0)
@@ -165,60 +224,755 @@ struct ObjPrimitive : Object {
   ObjPrimitive(char16_t vc)
       : Object(TypeKind::Char),
         vc(vc) {};
+
+  //
+  // fixed-width integer. (kind = I8 ... U64)
+  //   value is wrapped to the width, and kept in vi.
+  //   (sign-extended if signed; u64 is the bit pattern)
+  ObjPrimitive(TypeKind kind, i64 vi)
+      : Object(kind),
+        vi(Wrap(kind, vi)) {};
+
+  static i64 Wrap(TypeKind kind, i64 v) {
+    switch (kind) {
+    case TypeKind::I8:
+      return (i8)v;
+
+    case TypeKind::I16:
+      return (i16)v;
+
+    case TypeKind::I32:
+      return (i32)v;
+
+    case TypeKind::U8:
+      return (u8)v;
+
+    case TypeKind::U16:
+      return (u16)v;
+
+    case TypeKind::U32:
+      return (u32)v;
+    }
+
+    return v;
+  }
 };
 
+//
+// element of unboxed vector<bool>. (0 or 1)
+//   distinct type from u8, which is element of vector<u8>.
+//
+enum class Bool8 : u8 {};
+
+//
+// unboxed elements of vector<int>, vector<float>, vector<bool>, vector<char>,
+// and vectors of fixed-width integers.
+//
+using RawList = std::variant<Vec<i64>, Vec<double>, Vec<Bool8>, Vec<char16_t>, Vec<i8>,
+                             Vec<i16>, Vec<i32>, Vec<u8>, Vec<u16>, Vec<u32>, Vec<u64>>;
+
+//
+// ObjIterable
+//
+//  elements are shared between clones (copy-on-write).
+//  use GetMutableList() before modifying it; that makes a private copy
+//  of the list if it is shared with other objects.
+//
+//  vector of int, float, bool, char or fixed-width integer stores elements
+//  unboxed (RawList).
+//  GetList() and GetMutableList() are only for boxed list; use At(), Set(),
+//  GetRaw() or GetMutableRaw() if the list may be unboxed.
+//
 struct ObjIterable : Object {
-  ObjVector list;
+  bool IsUnboxed() const {
+    return this->_raw != nullptr;
+  }
+
+  std::span<ObjPointer const> GetList() const {
+    assert(!this->IsUnboxed());
+
+    if (this->_is_slice)
+      return std::span<ObjPointer const>(this->_list->data() + this->_offset, this->_count);
+
+    return *this->_list;
+  }
+
+  ObjVector& GetMutableList() {
+    assert(!this->IsUnboxed());
+
+    this->Detach();
+
+    return *this->_list;
+  }
+
+  //
+  // T = type of elements in RawList.
+  template <typename T>
+  std::span<T const> GetRaw() const {
+    auto const& v = std::get<Vec<T>>(*this->_raw);
+
+    if (this->_is_slice)
+      return std::span<T const>(v.data() + this->_offset, this->_count);
+
+    return v;
+  }
+
+  template <typename T>
+  Vec<T>& GetMutableRaw() {
+    this->Detach();
+
+    return std::get<Vec<T>>(*this->_raw);
+  }
 
-  ObjPointer& Append(ObjPointer obj) {
-    return this->list.emplace_back(obj);
+  //
+  // call f with list of elements to modify;
+  //   Vec<T>& if unboxed, otherwise ObjVector&.
+  template <typename F>
+  void VisitMutable(F&& f) {
+    this->Detach();
+
+    if (this->_raw)
+      std::visit(f, *this->_raw);
+    else
+      f(*this->_list);
   }
 
-  void AppendList(ObjPtr<ObjIterable> obj) {
-    for (auto&& e : obj->list)
-      this->Append(e->Clone());
+  bool IsShared() const {
+    return this->_is_slice ||
+           (this->_raw ? this->_raw.use_count() : this->_list.use_count()) >= 2;
   }
 
+  //
+  // element at index. (boxed if unboxed list)
+  ObjPointer At(size_t index) const;
+
+  void Set(size_t index, ObjPointer obj);
+
+  //
+  // make a slice referencing the list of this. (no copy)
+  //
+  ObjPtr<ObjIterable> Slice(size_t begin, size_t end) const;
+
+  void Append(ObjPointer const& obj);
+
+  void AppendList(ObjPtr<ObjIterable> obj);
+
+  void Insert(size_t index, ObjPointer const& obj);
+
+  // list must not be empty
+  ObjPointer Pop();
+
+  void Reserve(size_t count);
+  void Clear();
+
   size_t Count() const {
-    return this->list.size();
+    return this->_is_slice ? this->_count : this->buffer_size();
   }
 
+  size_t Capacity() const;
+
   ObjPointer Clone() const override;
   string ToString() const override;
+  void AppendTo(string& out) const override;
 
-  bool Equals(ObjPointer obj) const override {
-    if (!obj->type.is_iterable())
-      return false;
+  bool Equals(ObjPointer obj) const override;
 
-    if (this->list.size() != obj->As<ObjIterable>()->list.size())
-      return false;
+  ObjIterable(TypeInfo type);
 
-    for (auto it = this->list.begin(); auto&& e : obj->As<ObjIterable>()->list)
-      if (!(*it++)->Equals(e))
-        return false;
+  // copy of element for a private list.
+  static ObjPointer CopyElement(ObjPointer const& e);
 
-    return true;
+  //
+  // vector of this type is unboxed.
+  static bool IsUnboxedType(TypeKind kind);
+
+protected:
+  std::shared_ptr<ObjVector> _list; // nullptr if unboxed
+  std::shared_ptr<RawList> _raw;    // nullptr if boxed
+
+  //
+  // slice of other list:
+  //   refers [_offset, _offset + _count) of _list (or _raw).
+  bool _is_slice = false;
+  size_t _offset = 0;
+  size_t _count = 0;
+
+  // count of all elements in buffer (not slice)
+  size_t buffer_size() const;
+
+  // make the list private, if shared.
+  void Detach();
+};
+
+//
+// TypeKind::Tuple
+//
+//  fixed count of elements.
+//  up to inline_count elements are stored in the object itself,
+//  so a small tuple is a single allocation.
+//
+struct ObjTuple : Object {
+  static constexpr size_t inline_count = 4;
+
+  size_t Count() const {
+    return this->_count;
+  }
+
+  ObjPointer& At(size_t index) {
+    return this->Data()[index];
+  }
+
+  ObjPointer const& At(size_t index) const {
+    return this->Data()[index];
+  }
+
+  string ToString() const override;
+
+  ObjPointer Clone() const override;
+
+  bool Equals(ObjPointer obj) const override;
+
+  ObjTuple(TypeInfo type);
+
+private:
+  size_t _count;
+
+  ObjPointer _inline[inline_count];
+  std::unique_ptr<ObjPointer[]> _ext; // if count > inline_count
+
+  ObjPointer* Data() {
+    return this->_ext ? this->_ext.get() : this->_inline;
   }
 
-  ObjIterable(TypeInfo type)
-      : Object(type) {
+  ObjPointer const* Data() const {
+    return this->_ext ? this->_ext.get() : this->_inline;
   }
 };
 
-struct ObjString : ObjIterable {
-  ObjPointer SubString(size_t pos, size_t length = 0);
+//
+// ObjString
+//
+//  characters are stored in contiguous UTF-16 buffer.
+//  the buffer is shared between clones and slices (copy-on-write).
+//
+struct ObjString : Object {
+  std::u16string_view View() const {
+    if (this->_is_slice)
+      return std::u16string_view(*this->_buf).substr(this->_offset, this->_length);
+
+    return *this->_buf;
+  }
 
   size_t Length() const {
-    return this->list.size();
+    return this->_is_slice ? this->_length : this->_buf->length();
+  }
+
+  char16_t At(size_t index) const {
+    return this->View()[index];
+  }
+
+  //
+  // make a slice referencing the buffer of this. (no copy)
+  //
+  ObjPtr<ObjString> SubString(size_t pos, size_t length = std::u16string::npos) const;
+
+  //
+  // get the buffer to modify.
+  //   the buffer is copied if shared with other objects,
+  //   and cached hash and interned flag are dropped.
+  std::u16string& GetMutable();
+
+  //
+  // hash value of the content.
+  //   computed at first call, and cached in the object.
+  size_t Hash() const;
+
+  bool IsInterned() const {
+    return this->_interned;
   }
 
   string ToString() const override;
+  void AppendTo(string& out) const override;
   string ToStringAsMember() const override;
 
   ObjPointer Clone() const override;
 
+  bool Equals(ObjPointer obj) const override;
+
   ObjString(std::u16string const& str = u"");
+  ObjString(std::u16string&& str);
   ObjString(string const& str);
+  ObjString(std::shared_ptr<std::u16string> buf);
+
+  //
+  // get a string object sharing the buffer in intern table.
+  //   interned strings with same content have same buffer,
+  //   so equality of them is decided by comparing pointer.
+  static ObjPtr<ObjString> Intern(std::u16string_view str);
+
+private:
+  std::shared_ptr<std::u16string> _buf;
+
+  mutable size_t _hash = 0;
+  mutable bool _hash_cached = false;
+
+  bool _interned = false;
+
+  //
+  // slice of other string:
+  //   refers [_offset, _offset + _length) of _buf.
+  bool _is_slice = false;
+  size_t _offset = 0;
+  size_t _length = 0;
+};
+
+//
+// TypeKind::StringBuilder
+//
+struct ObjStringBuilder : Object {
+  size_t Length() const {
+    return this->_buf->length();
+  }
+
+  void Append(std::u16string_view str);
+  void Append(char16_t c);
+
+  void Reserve(size_t size);
+  void Clear();
+
+  //
+  // make a string object sharing the buffer. (no copy)
+  //   the buffer is copied at next append.
+  ObjPtr<ObjString> Build();
+
+  string ToString() const override;
+  void AppendTo(string& out) const override;
+
+  ObjPointer Clone() const override;
+
+  ObjStringBuilder();
+
+private:
+  std::shared_ptr<std::u16string> _buf;
+
+  std::u16string& GetMutable();
+};
+
+//
+// TypeKind::Regex
+//
+//  compiled program is shared with the cache.
+//
+struct ObjRegex : Object {
+  std::shared_ptr<regex::Regex> re;
+
+  string ToString() const override;
+
+  ObjPointer Clone() const override {
+    return ObjNew<ObjRegex>(this->re);
+  }
+
+  ObjRegex(std::shared_ptr<regex::Regex> re);
+};
+
+//
+// TypeKind::LineReader
+//
+//  reader of lines of a file. (see IO.h)
+//  clones share the reader and its position.
+//
+struct ObjLineReader : Object {
+  std::shared_ptr<io::LineReader> reader;
+
+  string ToString() const override {
+    return "LineReader";
+  }
+
+  ObjPointer Clone() const override {
+    return ObjNew<ObjLineReader>(this->reader);
+  }
+
+  ObjLineReader(std::shared_ptr<io::LineReader> reader);
+};
+
+//
+// TypeKind::Dict
+//
+//  hash table with open addressing. (like Swiss table)
+//
+//  slots are probed by groups of 8 control bytes, which hold 7 bits of hash
+//  of each slot; they are compared at once, and keys are compared only
+//  when the bits are matched.
+//
+//  entries are stored in a dense list in order of insertion,
+//  slots have index of entry. (so iteration is ordered)
+//
+//  the table is shared between clones (copy-on-write).
+//
+struct ObjDict : Object {
+  struct Entry {
+    ObjPointer key; // nullptr if removed
+    ObjPointer value;
+    size_t hash;
+  };
+
+  size_t Count() const {
+    return this->_table->count;
+  }
+
+  //
+  // returns nullptr if not found.
+  ObjPointer const* Find(ObjPointer const& key) const;
+
+  //
+  // get value to assign.
+  //   if not found, key is inserted with none.
+  ObjPointer& GetOrInsert(ObjPointer const& key);
+
+  void Insert(ObjPointer const& key, ObjPointer value) {
+    this->GetOrInsert(key) = std::move(value);
+  }
+
+  //
+  // insert key if not exists. (as set)
+  //   returns true if inserted.
+  bool Add(ObjPointer const& key) {
+    auto n = this->Count();
+
+    this->GetOrInsert(key);
+
+    return this->Count() != n;
+  }
+
+  bool Remove(ObjPointer const& key);
+
+  void Reserve(size_t count);
+  void Clear();
+
+  //
+  // call fn(key, value) for each entry in order of insertion.
+  template <typename F>
+  void ForEach(F&& fn) const {
+    for (auto&& e : this->_table->entries)
+      if (e.key)
+        fn(e.key, e.value);
+  }
+
+  //
+  // types which can be used as key.
+  static bool IsHashableType(TypeInfo const& type);
+
+  string ToString() const override;
+
+  ObjPointer Clone() const override;
+
+  bool Equals(ObjPointer obj) const override;
+
+  ObjDict(TypeInfo type);
+
+protected:
+  struct Table {
+    Vec<Entry> entries;
+
+    Vec<u8> ctrl;   // capacity + 8 (first 8 bytes are mirrored at end)
+    Vec<u32> slots; // index of entry
+
+    size_t count = 0;
+    size_t removed = 0; // removed entries, not yet compacted
+  };
+
+  std::shared_ptr<Table> _table;
+
+  Table& GetMutable();
+
+  void Rehash(size_t capacity);
+
+  size_t FindSlot(ObjPointer const& key, size_t hash) const;
+};
+
+//
+// TypeKind::Set
+//
+//  same hash table as dict; values are not used.
+//
+struct ObjSet : ObjDict {
+  string ToString() const override;
+
+  ObjPointer Clone() const override;
+
+  ObjSet(TypeInfo type);
+};
+
+//
+// TypeKind::BitSet
+//
+//  fixed size set of bits, stored in 64-bit words.
+//  bits after size in last word are always 0.
+//
+struct ObjBitSet : Object {
+  Vec<u64> words;
+  size_t size;
+
+  bool Test(size_t index) const {
+    return (this->words[index / 64] >> (index % 64)) & 1;
+  }
+
+  void Set(size_t index, bool value) {
+    auto& w = this->words[index / 64];
+    auto bit = u64(1) << (index % 64);
+
+    w = value ? w | bit : w & ~bit;
+  }
+
+  size_t Count() const;
+
+  //
+  // index of first set bit in [from, size), or size if not found.
+  size_t FindNext(size_t from) const;
+
+  string ToString() const override;
+
+  ObjPointer Clone() const override;
+
+  bool Equals(ObjPointer obj) const override;
+
+  ObjBitSet(size_t size);
+};
+
+//
+// TypeKind::OrderedMap
+//
+//  entries are sorted by key. (B+tree, see BTree.h)
+//  the tree is shared between clones (copy-on-write).
+//
+struct ObjOrderedMap : Object {
+  btree::BTree const& Get() const {
+    return *this->_tree;
+  }
+
+  btree::BTree& GetMutable();
+
+  string ToString() const override;
+
+  ObjPointer Clone() const override;
+
+  bool Equals(ObjPointer obj) const override;
+
+  ObjOrderedMap(TypeInfo type);
+
+private:
+  std::shared_ptr<btree::BTree> _tree;
+};
+
+//
+// TypeKind::Deque
+//
+//  ring buffer; capacity is always power of 2.
+//  the buffer is shared between clones (copy-on-write).
+//
+struct ObjDeque : Object {
+  struct Ring {
+    Vec<ObjPointer> buf;
+    size_t head = 0;
+    size_t count = 0;
+
+    ObjPointer& At(size_t index) {
+      return this->buf[(this->head + index) & (this->buf.size() - 1)];
+    }
+
+    ObjPointer const& At(size_t index) const {
+      return this->buf[(this->head + index) & (this->buf.size() - 1)];
+    }
+  };
+
+  size_t Count() const {
+    return this->_ring->count;
+  }
+
+  ObjPointer const& At(size_t index) const {
+    return this->_ring->At(index);
+  }
+
+  Ring& GetMutable();
+
+  void PushBack(ObjPointer obj);
+  void PushFront(ObjPointer obj);
+
+  // deque must not be empty
+  ObjPointer PopBack();
+  ObjPointer PopFront();
+
+  void Clear();
+
+  string ToString() const override;
+
+  ObjPointer Clone() const override;
+
+  bool Equals(ObjPointer obj) const override;
+
+  ObjDeque(TypeInfo type);
+
+private:
+  std::shared_ptr<Ring> _ring;
+
+  // make room for one more element
+  void Grow(Ring& r);
+};
+
+//
+// TypeKind::PriorityQueue
+//
+//  binary heap.
+//  largest element is on top, or smallest if reversed.
+//  element type is int, float, char or string.
+//
+struct ObjPriorityQueue : Object {
+  size_t Count() const {
+    return this->_heap->size();
+  }
+
+  // queue must not be empty
+  ObjPointer const& Top() const {
+    return this->_heap->front();
+  }
+
+  void Push(ObjPointer obj);
+
+  // queue must not be empty
+  ObjPointer Pop();
+
+  void Clear();
+
+  bool IsReversed() const {
+    return this->_reverse;
+  }
+
+  // heap is rebuilt if order is changed
+  void SetReversed(bool reverse);
+
+  //
+  // elements in order of priority.
+  Vec<ObjPointer> Sorted() const;
+
+  string ToString() const override;
+
+  ObjPointer Clone() const override;
+
+  bool Equals(ObjPointer obj) const override;
+
+  ObjPriorityQueue(TypeInfo type);
+
+private:
+  std::shared_ptr<Vec<ObjPointer>> _heap;
+
+  bool _reverse = false;
+
+  Vec<ObjPointer>& GetMutable();
+
+  // true if priority of a is lower than b
+  bool Less(ObjPointer const& a, ObjPointer const& b) const;
+
+  void SiftUp(Vec<ObjPointer>& h, size_t index);
+};
+
+//
+// TypeKind::Matrix
+//
+//  dense matrix of float.
+//  elements are stored in one contiguous array, row by row.
+//
+struct ObjMatrix : Object {
+  size_t rows;
+  size_t cols;
+
+  Vec<double> data;
+
+  double& At(size_t row, size_t col) {
+    return this->data[row * this->cols + col];
+  }
+
+  double At(size_t row, size_t col) const {
+    return this->data[row * this->cols + col];
+  }
+
+  double const* Row(size_t row) const {
+    return this->data.data() + row * this->cols;
+  }
+
+  string ToString() const override;
+
+  ObjPointer Clone() const override;
+
+  bool Equals(ObjPointer obj) const override;
+
+  // filled with 0
+  ObjMatrix(size_t rows, size_t cols);
+};
+
+//
+// TypeKind::Bytes
+//
+//  binary data; contiguous buffer of u8.
+//  the buffer is shared by Clone() and Slice(), and copied before modified,
+//  same as ObjString.
+//
+//  the buffer may be a read-only memory not owned by this (mapped file);
+//  it is kept alive by _owner, and copied to own buffer before modified.
+//
+struct ObjBytes : Object {
+  std::span<u8 const> View() const {
+    if (this->_is_slice)
+      return this->Buffer().subspan(this->_offset, this->_length);
+
+    return this->Buffer();
+  }
+
+  size_t Length() const {
+    return this->_is_slice ? this->_length : this->Buffer().size();
+  }
+
+  u8 const* Data() const {
+    return this->Buffer().data() + this->_offset;
+  }
+
+  //
+  // make a slice referencing the buffer of this. (no copy)
+  //
+  ObjPtr<ObjBytes> Slice(size_t pos, size_t length) const;
+
+  //
+  // get the buffer to modify.
+  //   the buffer is copied if shared with other objects, or this is a slice.
+  Vec<u8>& GetMutable();
+
+  string ToString() const override;
+
+  ObjPointer Clone() const override;
+
+  bool Equals(ObjPointer obj) const override;
+
+  ObjBytes(Vec<u8>&& data = {});
+  ObjBytes(std::shared_ptr<Vec<u8>> buf);
+
+  // view to memory owned by owner. (no copy)
+  ObjBytes(std::shared_ptr<void const> owner, std::span<u8 const> view);
+
+private:
+  std::shared_ptr<Vec<u8>> _buf;
+
+  std::shared_ptr<void const> _owner;
+  std::span<u8 const> _borrowed;
+
+  std::span<u8 const> Buffer() const {
+    return this->_owner ? this->_borrowed : std::span<u8 const>(*this->_buf);
+  }
+
+  //
+  // slice of other bytes:
+  //   refers [_offset, _offset + _length) of _buf.
+  bool _is_slice = false;
+  size_t _offset = 0;
+  size_t _length = 0;
 };
 
 //
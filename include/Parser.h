@@ -104,6 +104,9 @@ private:
     return new_expr(ASTKind::Assign, op, lhs, new_expr(kind, op, lhs, rhs));
   }
 
+  static ASTPtr<AST::CallFunc> new_slice(Token& op, ASTPointer obj, ASTPointer begin,
+                                         ASTPointer end);
+
   TokenVector& tokens;
   TokenIterator cur, end, ate;
 
@@ -112,6 +115,22 @@ private:
 
   bool _in_loop = false;
 
+  //
+  // statements to be placed after the current statement.
+  //   let (a, b) = expr;
+  //     ==>  let $tuple0 = expr;  let a = $tuple0[0];  let b = $tuple0[1];
+  ASTVector _following_stmts;
+  size_t _tuple_count = 0;
+
+  void append_stmt(ASTVector& list, ASTPointer stmt) {
+    list.emplace_back(stmt);
+
+    for (auto&& s : this->_following_stmts)
+      list.emplace_back(s);
+
+    this->_following_stmts.clear();
+  }
+
   int _typeparam_bracket_depth = 0;
 
   //
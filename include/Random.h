@@ -0,0 +1,75 @@
+#pragma once
+
+#include "types.h"
+
+//
+// Random number generator of interpreter.
+//
+//  xoshiro256** ; state is initialized by splitmix64 from a seed.
+//  seeded by std::random_device at first use, or by rand_seed().
+//
+namespace fire::rng {
+
+class Xoshiro256 {
+public:
+  void Seed(u64 seed);
+
+  u64 Next() {
+    u64* s = this->s;
+
+    u64 result = rotl(s[1] * 5, 7) * 9;
+    u64 t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+
+    return result;
+  }
+
+  // [0, 1)
+  double NextDouble() {
+    return (double)(this->Next() >> 11) * 0x1p-53;
+  }
+
+  //
+  // [0, n)  (n >= 1)
+  //   multiply-shift with rejection; no bias, no division in most cases.
+  u64 Bounded(u64 n);
+
+  // standard normal distribution
+  double Normal();
+
+  //
+  // bulk generation
+  //
+  void FillUniform(double* out, size_t n, double lo, double hi);
+
+  // [lo, lo + range)
+  void FillUniform(i64* out, size_t n, i64 lo, u64 range);
+
+  void FillNormal(double* out, size_t n, double mean, double stddev);
+
+  Xoshiro256(u64 seed) {
+    this->Seed(seed);
+  }
+
+private:
+  u64 s[4];
+
+  // second value of polar method
+  bool has_spare = false;
+  double spare = 0;
+
+  static u64 rotl(u64 x, int k) {
+    return (x << k) | (x >> (64 - k));
+  }
+};
+
+Xoshiro256& Get();
+
+} // namespace fire::rng
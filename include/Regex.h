@@ -0,0 +1,124 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <string_view>
+
+#include "types.h"
+
+//
+// Regular expression engine.
+//
+//  pattern is compiled to NFA, and matching runs on DFA which is constructed
+//  lazily from it (state is made at first visit). no backtracking,
+//  so matching time is linear to length of text.
+//
+//  semantics is leftmost-longest (POSIX).
+//
+//  supported syntax:
+//    .  [abc]  [^a-z]  \d \w \s \D \W \S  (a|b)  * + ? {m} {m,} {m,n}  ^ $
+//
+//  works on UTF-16 code units (same as ObjString).
+//
+namespace fire::regex {
+
+struct PatternError {
+  string msg;
+  size_t pos;
+};
+
+class Regex {
+public:
+  //
+  // throws PatternError if pattern is invalid.
+  static std::shared_ptr<Regex> Compile(std::u16string_view pattern);
+
+  std::u16string const& GetPattern() const {
+    return this->pattern;
+  }
+
+  // whole of str is matched
+  bool Match(std::u16string_view str);
+
+  //
+  // find leftmost-longest match in str, start from "from".
+  //   range of match is stored to [begin, end).
+  bool Search(std::u16string_view str, size_t from, size_t& begin, size_t& end);
+
+  Regex(std::u16string_view pattern);
+
+private:
+  struct Inst {
+    enum Op : u8 {
+      Char,  // code unit in set[arg] -> next
+      Split, // next, arg
+      Jump,  // next
+      AssertBegin,
+      AssertEnd,
+      Accept,
+    };
+
+    Op op;
+    int next = -1;
+    int arg = -1;
+  };
+
+  struct DFAState {
+    Vec<int> insts; // sorted, Char / AssertEnd / Accept only
+
+    bool accept = false;
+    bool accept_at_end = false;
+
+    Vec<int> next; // index by class; -1 = not yet constructed
+  };
+
+  struct DFA {
+    bool unanchored;
+
+    Vec<DFAState> states;
+    std::map<Vec<int>, int> state_map;
+
+    // [0] = start at middle of text, [1] = start at beginning of text
+    int start[2] = {-1, -1};
+
+    // incremented when all states are dropped
+    size_t generation = 0;
+  };
+
+  std::u16string pattern;
+
+  Vec<Inst> program;
+
+  Vec<Vec<std::pair<char16_t, char16_t>>> sets; // ranges of Char
+  Vec<Vec<bool>> set_has_class;                 // [set][class]
+
+  //
+  // code units are grouped to classes by ranges in pattern.
+  //   (units in same class are never distinguished)
+  Vec<char16_t> class_bounds;
+  u16 ascii_class[128];
+
+  DFA anchored;
+  DFA unanchored;
+
+  int class_of(char16_t c) const;
+
+  void make_classes();
+
+  void add_closure(Vec<int>& out, Vec<bool>& visited, int pc, bool at_begin,
+                   bool at_end) const;
+
+  int get_state(DFA& dfa, Vec<int>&& insts);
+  int get_start(DFA& dfa, bool at_begin);
+  int step(DFA& dfa, int state, int cls);
+
+  friend class Compiler;
+};
+
+//
+// get compiled regex from cache. (or compile, and store to cache)
+//   cache is LRU, keyed by pattern text.
+//
+std::shared_ptr<Regex> get_compiled(std::u16string_view pattern);
+
+} // namespace fire::regex
@@ -629,6 +629,11 @@ private:
 
   TypeInfo make_functor_type(ASTPtr<AST::Function> ast);
   TypeInfo make_functor_type(builtins::Function const* builtin);
+  TypeInfo make_functor_type(builtins::Function const* builtin, TypeInfo const& self);
+
+  TypeInfo ResolveBuiltinTemplateType(TypeInfo const& type,
+                                      builtins::Function const* builtin,
+                                      TypeInfo const& self);
 
   std::map<ASTPtr<AST::Class>, bool> _class_analysing_flag_map;
 
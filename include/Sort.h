@@ -0,0 +1,313 @@
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+#include "types.h"
+
+//
+// Sorting of vectors.
+//
+//  int, float:  LSD radix sort  (stable)
+//  char:        pdqsort
+//  string:      pdqsort, or merge sort if stable
+//
+//  large arrays are split into chunks, which are sorted by threads and
+//  merged in parallel.
+//
+namespace fire::sort {
+
+void Sort(i64* a, size_t n);
+void Sort(double* a, size_t n);
+void Sort(char16_t* a, size_t n);
+
+// elements are ObjString
+void SortStrings(ObjPointer* a, size_t n, bool stable);
+
+//
+// pattern-defeating quicksort.
+//
+//  quicksort with median-of-3 (ninther for large range) pivot.
+//   - partitions which look already sorted are finished by insertion sort
+//     with a limit of moves.
+//   - unbalanced partitions shuffle some elements to break patterns, and
+//     fall back to heap sort if it happens too many times.
+//   - equal elements are put into left partition when the pivot is equal
+//     to the element before the range. (many duplicates: O(n))
+//
+namespace pdq {
+
+constexpr ptrdiff_t insertion_sort_threshold = 24;
+constexpr ptrdiff_t ninther_threshold = 128;
+constexpr ptrdiff_t partial_insertion_sort_limit = 8;
+
+template <typename It, typename Less>
+void insertion_sort(It begin, It end, Less& less) {
+  if (begin == end)
+    return;
+
+  for (It cur = begin + 1; cur != end; ++cur) {
+    if (less(*cur, *(cur - 1))) {
+      auto tmp = std::move(*cur);
+      It sift = cur;
+
+      do {
+        *sift = std::move(*(sift - 1));
+        --sift;
+      } while (sift != begin && less(tmp, *(sift - 1)));
+
+      *sift = std::move(tmp);
+    }
+  }
+}
+
+// *(begin - 1) is not greater than any element in range; it is a sentinel.
+template <typename It, typename Less>
+void unguarded_insertion_sort(It begin, It end, Less& less) {
+  if (begin == end)
+    return;
+
+  for (It cur = begin + 1; cur != end; ++cur) {
+    if (less(*cur, *(cur - 1))) {
+      auto tmp = std::move(*cur);
+      It sift = cur;
+
+      do {
+        *sift = std::move(*(sift - 1));
+        --sift;
+      } while (less(tmp, *(sift - 1)));
+
+      *sift = std::move(tmp);
+    }
+  }
+}
+
+//
+// insertion sort, but gives up if too many elements are moved.
+//   returns true if range is sorted.
+template <typename It, typename Less>
+bool partial_insertion_sort(It begin, It end, Less& less) {
+  if (begin == end)
+    return true;
+
+  ptrdiff_t moved = 0;
+
+  for (It cur = begin + 1; cur != end; ++cur) {
+    if (less(*cur, *(cur - 1))) {
+      auto tmp = std::move(*cur);
+      It sift = cur;
+
+      do {
+        *sift = std::move(*(sift - 1));
+        --sift;
+      } while (sift != begin && less(tmp, *(sift - 1)));
+
+      *sift = std::move(tmp);
+      moved += cur - sift;
+    }
+
+    if (moved > partial_insertion_sort_limit)
+      return false;
+  }
+
+  return true;
+}
+
+template <typename It, typename Less>
+void sort2(It a, It b, Less& less) {
+  if (less(*b, *a))
+    std::iter_swap(a, b);
+}
+
+template <typename It, typename Less>
+void sort3(It a, It b, It c, Less& less) {
+  sort2(a, b, less);
+  sort2(b, c, less);
+  sort2(a, b, less);
+}
+
+//
+// partition by pivot *begin; elements equal to pivot go to right.
+//   returns position of pivot, and whether the range was already partitioned.
+//
+template <typename It, typename Less>
+std::pair<It, bool> partition_right(It begin, It end, Less& less) {
+  auto pivot = std::move(*begin);
+
+  It first = begin;
+  It last = end;
+
+  // median-of-3 guarantees an element >= pivot exists
+  while (less(*++first, pivot))
+    ;
+
+  if (first - 1 == begin)
+    while (first < last && !less(*--last, pivot))
+      ;
+  else
+    while (!less(*--last, pivot))
+      ;
+
+  bool already_partitioned = first >= last;
+
+  while (first < last) {
+    std::iter_swap(first, last);
+
+    while (less(*++first, pivot))
+      ;
+
+    while (!less(*--last, pivot))
+      ;
+  }
+
+  It pivot_pos = first - 1;
+
+  *begin = std::move(*pivot_pos);
+  *pivot_pos = std::move(pivot);
+
+  return {pivot_pos, already_partitioned};
+}
+
+//
+// partition by pivot *begin; elements equal to pivot go to left.
+//   used when pivot equals to the element before range;
+//   left partition has only equal elements then, and is not sorted again.
+//
+template <typename It, typename Less>
+It partition_left(It begin, It end, Less& less) {
+  auto pivot = std::move(*begin);
+
+  It first = begin;
+  It last = end;
+
+  while (less(pivot, *--last))
+    ;
+
+  if (last + 1 == end)
+    while (first < last && !less(pivot, *++first))
+      ;
+  else
+    while (!less(pivot, *++first))
+      ;
+
+  while (first < last) {
+    std::iter_swap(first, last);
+
+    while (less(pivot, *--last))
+      ;
+
+    while (!less(pivot, *++first))
+      ;
+  }
+
+  It pivot_pos = last;
+
+  *begin = std::move(*pivot_pos);
+  *pivot_pos = std::move(pivot);
+
+  return pivot_pos;
+}
+
+template <typename It, typename Less>
+void sort_loop(It begin, It end, Less& less, int bad_allowed, bool leftmost) {
+  while (true) {
+    ptrdiff_t size = end - begin;
+
+    if (size < insertion_sort_threshold) {
+      if (leftmost)
+        insertion_sort(begin, end, less);
+      else
+        unguarded_insertion_sort(begin, end, less);
+
+      return;
+    }
+
+    // pivot is moved to *begin
+    ptrdiff_t half = size / 2;
+
+    if (size > ninther_threshold) {
+      sort3(begin, begin + half, end - 1, less);
+      sort3(begin + 1, begin + (half - 1), end - 2, less);
+      sort3(begin + 2, begin + (half + 1), end - 3, less);
+      sort3(begin + (half - 1), begin + half, begin + (half + 1), less);
+      std::iter_swap(begin, begin + half);
+    }
+    else {
+      sort3(begin + half, begin, end - 1, less);
+    }
+
+    if (!leftmost && !less(*(begin - 1), *begin)) {
+      begin = partition_left(begin, end, less) + 1;
+      continue;
+    }
+
+    auto [pivot_pos, already_partitioned] = partition_right(begin, end, less);
+
+    ptrdiff_t l_size = pivot_pos - begin;
+    ptrdiff_t r_size = end - (pivot_pos + 1);
+
+    bool highly_unbalanced = l_size < size / 8 || r_size < size / 8;
+
+    if (highly_unbalanced) {
+      if (--bad_allowed == 0) {
+        std::make_heap(begin, end, less);
+        std::sort_heap(begin, end, less);
+        return;
+      }
+
+      // break patterns
+      if (l_size >= insertion_sort_threshold) {
+        std::iter_swap(begin, begin + l_size / 4);
+        std::iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+
+        if (l_size > ninther_threshold) {
+          std::iter_swap(begin + 1, begin + (l_size / 4 + 1));
+          std::iter_swap(begin + 2, begin + (l_size / 4 + 2));
+          std::iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+          std::iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+        }
+      }
+
+      if (r_size >= insertion_sort_threshold) {
+        std::iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+        std::iter_swap(end - 1, end - r_size / 4);
+
+        if (r_size > ninther_threshold) {
+          std::iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+          std::iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+          std::iter_swap(end - 2, end - (1 + r_size / 4));
+          std::iter_swap(end - 3, end - (2 + r_size / 4));
+        }
+      }
+    }
+    else if (already_partitioned &&
+             partial_insertion_sort(begin, pivot_pos, less) &&
+             partial_insertion_sort(pivot_pos + 1, end, less)) {
+      return;
+    }
+
+    // recurse into left, loop for right
+    sort_loop(begin, pivot_pos, less, bad_allowed, leftmost);
+
+    begin = pivot_pos + 1;
+    leftmost = false;
+  }
+}
+
+} // namespace pdq
+
+template <typename It, typename Less>
+void PdqSort(It begin, It end, Less less) {
+  if (end - begin < 2)
+    return;
+
+  int log2 = 0;
+
+  for (auto n = end - begin; n > 1; n >>= 1)
+    log2++;
+
+  pdq::sort_loop(begin, end, less, log2, true);
+}
+
+} // namespace fire::sort
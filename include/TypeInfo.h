@@ -12,12 +12,31 @@ enum class TypeKind : u8 {
   Float,
   Bool,
 
+  // fixed-width integers (wrapping)
+  I8,
+  I16,
+  I32,
+  U8,
+  U16,
+  U32,
+  U64,
+
   Char,
   String,
+  StringBuilder,
+  Regex,
+  LineReader,
 
   Vector,
   Tuple,
   Dict,
+  OrderedMap,
+  Set,
+  BitSet,
+  Deque,
+  PriorityQueue,
+  Matrix,
+  Bytes,
 
   Enumerator,
   Instance, // instance of class
@@ -70,11 +89,28 @@ struct TypeInfo {
     case TypeKind::Int:
     case TypeKind::Float:
     case TypeKind::Bool:
+    case TypeKind::I8:
+    case TypeKind::I16:
+    case TypeKind::I32:
+    case TypeKind::U8:
+    case TypeKind::U16:
+    case TypeKind::U32:
+    case TypeKind::U64:
     case TypeKind::Char:
     case TypeKind::String:
+    case TypeKind::StringBuilder:
+    case TypeKind::Regex:
+    case TypeKind::LineReader:
     case TypeKind::Vector:
     case TypeKind::Tuple:
     case TypeKind::Dict:
+    case TypeKind::OrderedMap:
+    case TypeKind::Set:
+    case TypeKind::BitSet:
+    case TypeKind::Deque:
+    case TypeKind::PriorityQueue:
+    case TypeKind::Matrix:
+    case TypeKind::Bytes:
       return true;
     }
 
@@ -84,6 +120,11 @@ struct TypeInfo {
   bool is_iterable() const;
 
   bool is_numeric() const;
+
+  // i8, i16, i32, u8, u16, u32, u64
+  bool is_fixed_int() const {
+    return this->kind >= TypeKind::I8 && this->kind <= TypeKind::U64;
+  }
   bool is_numeric_or_char() const;
 
   bool is_char_or_str() const;
@@ -100,6 +141,9 @@ struct TypeInfo {
 
   static TypeInfo make_instance_type(ASTPtr<AST::Class> ast);
 
+  // named TypeKind::Unknown (used in signature of builtin generic types)
+  static TypeInfo make_template_param(string const& name);
+
   static TypeKind from_name(string const& name);
 
   static bool is_primitive_name(std::string_view);
@@ -2,8 +2,6 @@
 
 #include <any>
 #include <string>
-#include <locale>
-#include <codecvt>
 #include <sstream>
 #include <functional>
 
@@ -43,8 +41,21 @@ string remove_color(string str);
 i64 get_length_without_color(string const& str);
 i64 get_color_length_in_str(string const& str);
 
-string to_u8string(std::u16string const& str);
-std::u16string to_u16string(string const& str);
+//
+// UTF-8 <--> UTF-16
+//   invalid sequences are replaced with U+FFFD.
+//
+string to_u8string(std::u16string_view str);
+std::u16string to_u16string(string_view str);
+
+void append_u8string(string& out, std::u16string_view str);
+
+//
+// search in UTF-16 string.
+//   returns std::u16string_view::npos if not found.
+//
+size_t find_u16(std::u16string_view str, char16_t c, size_t pos = 0);
+size_t find_u16(std::u16string_view str, std::u16string_view s, size_t pos = 0);
 
 string get_base_name(string path);
 
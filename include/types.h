@@ -112,6 +112,8 @@ namespace builtins {
 struct Function;
 struct MemberVariable;
 
+struct FormatString;
+
 } // namespace builtins
 
 #if _DBG_DONT_USE_SMART_PTR_
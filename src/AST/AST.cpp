@@ -20,6 +20,8 @@ std::pair<ASTKind, char const*> const ASTKindNameArray[] = {
     {ASTKind::LambdaFunc, "LambdaFunc"},
     {ASTKind::OverloadResolutionGuide, "OverloadResolutionGuide"},
     {ASTKind::Array, "Array"},
+    {ASTKind::Dict, "Dict"},
+    {ASTKind::Tuple, "Tuple"},
     {ASTKind::IndexRef, "IndexRef"},
     {ASTKind::MemberAccess, "MemberAccess"},
     {ASTKind::RefMemberVar, "RefMemberVar"},
@@ -94,6 +94,27 @@ string ToString(ASTPointer ast) {
     return "[" + join(", ", x->elements) + "]";
   }
 
+  case ASTKind::Tuple: {
+    auto x = ast->As<Array>();
+
+    return "(" + join(", ", x->elements) + (x->elements.size() == 1 ? ",)" : ")");
+  }
+
+  case ASTKind::Dict: {
+    auto x = ast->As<Dict>();
+
+    string s;
+
+    for (size_t i = 0; i < x->keys.size(); i++) {
+      if (i > 0)
+        s += ", ";
+
+      s += ToString(x->keys[i]) + ": " + ToString(x->values[i]);
+    }
+
+    return "{" + s + "}";
+  }
+
   case ASTKind::ScopeResol: {
     auto x = ast->As<ScopeResol>();
 
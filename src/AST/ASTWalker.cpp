@@ -63,7 +63,8 @@ void walk_ast(ASTPointer ast, std::function<bool(ASTWalkerLocation, ASTPointer)>
     break;
   }
 
-  case Kind::Array: {
+  case Kind::Array:
+  case Kind::Tuple: {
     auto x = ast->As<AST::Array>();
 
     for (auto&& y : x->elements)
@@ -72,6 +73,17 @@ void walk_ast(ASTPointer ast, std::function<bool(ASTWalkerLocation, ASTPointer)>
     break;
   }
 
+  case Kind::Dict: {
+    auto x = ast->As<AST::Dict>();
+
+    for (size_t i = 0; i < x->keys.size(); i++) {
+      walk_ast(x->keys[i], fn);
+      walk_ast(x->values[i], fn);
+    }
+
+    break;
+  }
+
   case Kind::Block:
     for (auto&& x : ast->As<AST::Block>()->list)
       walk_ast(x, fn);
@@ -100,6 +112,19 @@ void walk_ast(ASTPointer ast, std::function<bool(ASTWalkerLocation, ASTPointer)>
   case Kind::Switch:
     todo_impl;
 
+  case Kind::Match: {
+    auto x = ast->As<AST::Match>();
+
+    walk_ast(x->cond, fn);
+
+    for (auto&& p : x->patterns) {
+      walk_ast(p.expr, fn);
+      walk_ast(p.block, fn);
+    }
+
+    break;
+  }
+
   case Kind::While: {
     auto d = ast->As<AST::Statement>()->data_while;
 
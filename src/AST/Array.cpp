@@ -9,6 +9,8 @@ ASTPtr<Array> Array::New(Token tok) {
 ASTPointer Array::Clone() const {
   auto x = New(this->token);
 
+  x->kind = this->kind; // Array or Tuple
+
   for (ASTPointer const& e : this->elements)
     x->elements.emplace_back(e->Clone());
 
@@ -0,0 +1,25 @@
+#include "AST.h"
+
+namespace fire::AST {
+
+ASTPtr<Dict> Dict::New(Token tok) {
+  return ASTNew<Dict>(tok);
+}
+
+ASTPointer Dict::Clone() const {
+  auto x = New(this->token);
+
+  for (ASTPointer const& k : this->keys)
+    x->keys.emplace_back(k->Clone());
+
+  for (ASTPointer const& v : this->values)
+    x->values.emplace_back(v->Clone());
+
+  return x;
+}
+
+Dict::Dict(Token tok)
+    : Base(ASTKind::Dict, tok) {
+}
+
+} // namespace fire::AST
@@ -0,0 +1,560 @@
+#include <bit>
+
+#include "BTree.h"
+#include "Object.h"
+
+namespace fire::btree {
+
+void BTree::Cursor::Next() {
+  this->index++;
+
+  while (this->leaf && this->index >= this->leaf->count) {
+    this->leaf = this->leaf->next;
+    this->index = 0;
+  }
+}
+
+bool BTree::IsOrderedType(TypeKind kind) {
+  switch (kind) {
+  case TypeKind::Int:
+  case TypeKind::Float:
+  case TypeKind::Char:
+  case TypeKind::String:
+    return true;
+  }
+
+  return false;
+}
+
+BTree::BTree(TypeKind key_kind)
+    : key_kind(key_kind) {
+}
+
+BTree::BTree(BTree const& other)
+    : key_kind(other.key_kind),
+      count(other.count) {
+  Leaf* prev = nullptr;
+
+  if (other.root)
+    this->root = copy_node(other.root.get(), prev);
+}
+
+std::unique_ptr<BTree::Node> BTree::copy_node(Node const* node, Leaf*& prev_leaf) {
+  if (node->leaf) {
+    auto src = static_cast<Leaf const*>(node);
+    auto leaf = std::make_unique<Leaf>();
+
+    leaf->count = src->count;
+
+    for (size_t i = 0; i < src->count; i++) {
+      leaf->prefix[i] = src->prefix[i];
+      leaf->keys[i] = src->keys[i];
+      leaf->values[i] = ObjIterable::CopyElement(src->values[i]);
+    }
+
+    if (prev_leaf)
+      prev_leaf->next = leaf.get();
+
+    prev_leaf = leaf.get();
+
+    return leaf;
+  }
+
+  auto src = static_cast<Inner const*>(node);
+  auto inner = std::make_unique<Inner>();
+
+  inner->count = src->count;
+
+  for (size_t i = 0; i < src->count; i++) {
+    inner->prefix[i] = src->prefix[i];
+    inner->keys[i] = src->keys[i];
+  }
+
+  for (size_t i = 0; i <= src->count; i++)
+    inner->children[i] = copy_node(src->children[i].get(), prev_leaf);
+
+  return inner;
+}
+
+//
+// prefix is ordered same as the key:
+//   int    sign bit is flipped
+//   float  negative: all bits are flipped, positive: sign bit is set
+//   string first 4 code units (big endian, padded with 0)
+//
+BTree::Key BTree::make_key(ObjPointer const& obj) const {
+  u64 prefix = 0;
+
+  switch (this->key_kind) {
+  case TypeKind::Int:
+    prefix = (u64)obj->get_vi() ^ (1ULL << 63);
+    break;
+
+  case TypeKind::Float: {
+    auto bits = std::bit_cast<u64>(obj->get_vf());
+
+    prefix = (bits >> 63) ? ~bits : bits | (1ULL << 63);
+    break;
+  }
+
+  case TypeKind::Char:
+    prefix = obj->get_vc();
+    break;
+
+  case TypeKind::String: {
+    auto str = obj->As<ObjString>()->View();
+
+    for (size_t i = 0; i < 4; i++)
+      prefix = (prefix << 16) | (i < str.length() ? str[i] : 0);
+
+    break;
+  }
+
+  default:
+    todo_impl;
+  }
+
+  return {prefix, &*obj};
+}
+
+int BTree::compare(Key const& key, Node const* node, size_t index) const {
+  auto p = node->prefix[index];
+
+  if (key.prefix != p)
+    return key.prefix < p ? -1 : 1;
+
+  // same prefix: compare whole of string
+  if (this->key_kind == TypeKind::String) {
+    auto a = static_cast<ObjString const*>(key.obj)->View();
+    auto b = node->keys[index]->As<ObjString>()->View();
+
+    return a.compare(b);
+  }
+
+  return 0;
+}
+
+int BTree::Compare(ObjPointer const& a, ObjPointer const& b) const {
+  auto ka = this->make_key(a);
+  auto kb = this->make_key(b);
+
+  if (ka.prefix != kb.prefix)
+    return ka.prefix < kb.prefix ? -1 : 1;
+
+  if (this->key_kind == TypeKind::String)
+    return a->As<ObjString>()->View().compare(b->As<ObjString>()->View());
+
+  return 0;
+}
+
+// first index which keys[index] >= key
+size_t BTree::lower_index(Node const* node, Key const& key) const {
+  size_t lo = 0, hi = node->count;
+
+  while (lo < hi) {
+    size_t mid = (lo + hi) / 2;
+
+    if (this->compare(key, node, mid) > 0)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  return lo;
+}
+
+// first index which keys[index] > key
+size_t BTree::upper_index(Node const* node, Key const& key) const {
+  size_t lo = 0, hi = node->count;
+
+  while (lo < hi) {
+    size_t mid = (lo + hi) / 2;
+
+    if (this->compare(key, node, mid) >= 0)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  return lo;
+}
+
+ObjPointer const* BTree::Find(ObjPointer const& key) const {
+  auto cur = this->LowerBound(key);
+
+  if (cur.IsEnd() || this->compare(this->make_key(key), cur.leaf, cur.index) != 0)
+    return nullptr;
+
+  return &cur.GetValue();
+}
+
+ObjPointer& BTree::GetOrInsert(ObjPointer const& key) {
+  if (!this->root)
+    this->root = std::make_unique<Leaf>();
+
+  Split split;
+
+  auto ret = this->insert(this->root.get(), this->make_key(key), key, split);
+
+  // root is splitted: tree grows up
+  if (split.node) {
+    auto new_root = std::make_unique<Inner>();
+
+    new_root->count = 1;
+    new_root->prefix[0] = split.prefix;
+    new_root->keys[0] = std::move(split.key);
+    new_root->children[0] = std::move(this->root);
+    new_root->children[1] = std::move(split.node);
+
+    this->root = std::move(new_root);
+  }
+
+  return *ret;
+}
+
+//
+// insert to node; if the node is overflowed, it is splitted to two nodes,
+// and new one (right side) is returned in split.
+//
+ObjPointer* BTree::insert(Node* node, Key const& key, ObjPointer const& key_obj,
+                          Split& split) {
+  if (node->leaf) {
+    auto leaf = static_cast<Leaf*>(node);
+    auto i = this->lower_index(leaf, key);
+
+    if (i < leaf->count && this->compare(key, leaf, i) == 0)
+      return &leaf->values[i];
+
+    for (size_t j = leaf->count; j > i; j--) {
+      leaf->prefix[j] = leaf->prefix[j - 1];
+      leaf->keys[j] = std::move(leaf->keys[j - 1]);
+      leaf->values[j] = std::move(leaf->values[j - 1]);
+    }
+
+    // strings are copied (they are mutable); key in tree must not be changed.
+    leaf->prefix[i] = key.prefix;
+    leaf->keys[i] = key_obj->is_string() ? key_obj->Clone() : key_obj;
+    leaf->values[i] = ObjNew<ObjNone>();
+
+    leaf->count++;
+    this->count++;
+
+    if (leaf->count <= max_keys)
+      return &leaf->values[i];
+
+    auto right = std::make_unique<Leaf>();
+    size_t half = leaf->count / 2;
+
+    for (size_t j = half; j < leaf->count; j++) {
+      right->prefix[j - half] = leaf->prefix[j];
+      right->keys[j - half] = std::move(leaf->keys[j]);
+      right->values[j - half] = std::move(leaf->values[j]);
+    }
+
+    right->count = leaf->count - half;
+    leaf->count = half;
+
+    right->next = leaf->next;
+    leaf->next = right.get();
+
+    auto ret = i < half ? &leaf->values[i] : &right->values[i - half];
+
+    split.prefix = right->prefix[0];
+    split.key = right->keys[0];
+    split.node = std::move(right);
+
+    return ret;
+  }
+
+  auto inner = static_cast<Inner*>(node);
+  auto i = this->upper_index(inner, key);
+
+  Split child;
+
+  auto ret = this->insert(inner->children[i].get(), key, key_obj, child);
+
+  if (!child.node)
+    return ret;
+
+  for (size_t j = inner->count; j > i; j--) {
+    inner->prefix[j] = inner->prefix[j - 1];
+    inner->keys[j] = std::move(inner->keys[j - 1]);
+  }
+
+  for (size_t j = inner->count + 1; j > i + 1; j--)
+    inner->children[j] = std::move(inner->children[j - 1]);
+
+  inner->prefix[i] = child.prefix;
+  inner->keys[i] = std::move(child.key);
+  inner->children[i + 1] = std::move(child.node);
+
+  inner->count++;
+
+  if (inner->count <= max_keys)
+    return ret;
+
+  // middle key goes up to parent
+  auto right = std::make_unique<Inner>();
+  size_t mid = inner->count / 2;
+
+  split.prefix = inner->prefix[mid];
+  split.key = std::move(inner->keys[mid]);
+
+  for (size_t j = mid + 1; j < inner->count; j++) {
+    right->prefix[j - mid - 1] = inner->prefix[j];
+    right->keys[j - mid - 1] = std::move(inner->keys[j]);
+  }
+
+  for (size_t j = mid + 1; j <= inner->count; j++)
+    right->children[j - mid - 1] = std::move(inner->children[j]);
+
+  right->count = inner->count - mid - 1;
+  inner->count = mid;
+
+  split.node = std::move(right);
+
+  return ret;
+}
+
+bool BTree::Remove(ObjPointer const& key) {
+  if (!this->root || !this->remove(this->root.get(), this->make_key(key)))
+    return false;
+
+  // root has only one child: tree shrinks
+  if (!this->root->leaf && this->root->count == 0)
+    this->root = std::move(static_cast<Inner*>(this->root.get())->children[0]);
+
+  return true;
+}
+
+bool BTree::remove(Node* node, Key const& key) {
+  if (node->leaf) {
+    auto leaf = static_cast<Leaf*>(node);
+    auto i = this->lower_index(leaf, key);
+
+    if (i >= leaf->count || this->compare(key, leaf, i) != 0)
+      return false;
+
+    for (size_t j = i + 1; j < leaf->count; j++) {
+      leaf->prefix[j - 1] = leaf->prefix[j];
+      leaf->keys[j - 1] = std::move(leaf->keys[j]);
+      leaf->values[j - 1] = std::move(leaf->values[j]);
+    }
+
+    leaf->count--;
+    leaf->keys[leaf->count] = nullptr;
+    leaf->values[leaf->count] = nullptr;
+
+    this->count--;
+
+    return true;
+  }
+
+  auto inner = static_cast<Inner*>(node);
+  auto i = this->upper_index(inner, key);
+
+  if (!this->remove(inner->children[i].get(), key))
+    return false;
+
+  this->fix_child(inner, i);
+
+  return true;
+}
+
+//
+// children[index] of parent may have too few keys after removal.
+// merge it with a sibling, or move some keys from the sibling.
+//
+void BTree::fix_child(Inner* parent, size_t index) {
+  if (parent->children[index]->count >= min_keys || parent->count == 0)
+    return;
+
+  // fix pair of (li, li + 1)
+  size_t li = index > 0 ? index - 1 : 0;
+
+  auto left = parent->children[li].get();
+  auto right = parent->children[li + 1].get();
+
+  // gather all of left, (separator), right
+  Vec<u64> prefix;
+  ObjVector keys;
+  ObjVector values;
+  Vec<std::unique_ptr<Node>> children;
+
+  auto gather = [&](Node* node) {
+    for (size_t i = 0; i < node->count; i++) {
+      prefix.emplace_back(node->prefix[i]);
+      keys.emplace_back(std::move(node->keys[i]));
+    }
+
+    if (node->leaf) {
+      for (size_t i = 0; i < node->count; i++)
+        values.emplace_back(std::move(static_cast<Leaf*>(node)->values[i]));
+    }
+    else {
+      for (size_t i = 0; i <= node->count; i++)
+        children.emplace_back(std::move(static_cast<Inner*>(node)->children[i]));
+    }
+
+    node->count = 0;
+  };
+
+  gather(left);
+
+  if (!left->leaf) {
+    prefix.emplace_back(parent->prefix[li]);
+    keys.emplace_back(parent->keys[li]);
+  }
+
+  gather(right);
+
+  // put keys [begin, end) to node
+  auto fill = [&](Node* node, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      node->prefix[i - begin] = prefix[i];
+      node->keys[i - begin] = std::move(keys[i]);
+    }
+
+    node->count = end - begin;
+
+    if (node->leaf) {
+      for (size_t i = begin; i < end; i++)
+        static_cast<Leaf*>(node)->values[i - begin] = std::move(values[i]);
+    }
+    else {
+      for (size_t i = begin; i <= end; i++)
+        static_cast<Inner*>(node)->children[i - begin] = std::move(children[i]);
+    }
+  };
+
+  size_t total = keys.size();
+
+  // merge to left, and remove right
+  if (total <= max_keys) {
+    fill(left, 0, total);
+
+    if (left->leaf)
+      static_cast<Leaf*>(left)->next = static_cast<Leaf*>(right)->next;
+
+    for (size_t j = li + 1; j < parent->count; j++) {
+      parent->prefix[j - 1] = parent->prefix[j];
+      parent->keys[j - 1] = std::move(parent->keys[j]);
+    }
+
+    for (size_t j = li + 2; j <= parent->count; j++)
+      parent->children[j - 1] = std::move(parent->children[j]);
+
+    parent->count--;
+    parent->keys[parent->count] = nullptr;
+    parent->children[parent->count + 1] = nullptr;
+
+    return;
+  }
+
+  // redistribute evenly
+  size_t mid = total / 2;
+
+  if (left->leaf) {
+    parent->prefix[li] = prefix[mid];
+    parent->keys[li] = keys[mid];
+
+    fill(left, 0, mid);
+    fill(right, mid, total);
+  }
+  else {
+    // keys[mid] goes up to parent
+    parent->prefix[li] = prefix[mid];
+    parent->keys[li] = keys[mid];
+
+    fill(left, 0, mid);
+
+    // children of right begins from (mid + 1)
+    for (size_t i = mid + 1; i < total; i++) {
+      right->prefix[i - mid - 1] = prefix[i];
+      right->keys[i - mid - 1] = std::move(keys[i]);
+    }
+
+    for (size_t i = mid + 1; i <= total; i++)
+      static_cast<Inner*>(right)->children[i - mid - 1] = std::move(children[i]);
+
+    right->count = total - mid - 1;
+  }
+}
+
+void BTree::Clear() {
+  this->root = nullptr;
+  this->count = 0;
+}
+
+BTree::Cursor BTree::Begin() const {
+  Cursor cur;
+
+  if (!this->root)
+    return cur;
+
+  Node const* node = this->root.get();
+
+  while (!node->leaf)
+    node = static_cast<Inner const*>(node)->children[0].get();
+
+  cur.leaf = static_cast<Leaf const*>(node);
+
+  if (cur.leaf->count == 0)
+    cur.leaf = nullptr;
+
+  return cur;
+}
+
+BTree::Cursor BTree::Last() const {
+  Cursor cur;
+
+  if (!this->root)
+    return cur;
+
+  Node const* node = this->root.get();
+
+  while (!node->leaf)
+    node = static_cast<Inner const*>(node)->children[node->count].get();
+
+  if (node->count != 0) {
+    cur.leaf = static_cast<Leaf const*>(node);
+    cur.index = node->count - 1;
+  }
+
+  return cur;
+}
+
+BTree::Cursor BTree::bound(ObjPointer const& key, bool upper) const {
+  Cursor cur;
+
+  if (!this->root)
+    return cur;
+
+  auto k = this->make_key(key);
+
+  Node const* node = this->root.get();
+
+  while (!node->leaf)
+    node = static_cast<Inner const*>(node)->children[this->upper_index(node, k)].get();
+
+  cur.leaf = static_cast<Leaf const*>(node);
+  cur.index = upper ? this->upper_index(node, k) : this->lower_index(node, k);
+
+  // at end of the leaf: go to next
+  if (cur.index >= node->count) {
+    cur.index--;
+    cur.Next();
+  }
+
+  return cur;
+}
+
+BTree::Cursor BTree::LowerBound(ObjPointer const& key) const {
+  return this->bound(key, false);
+}
+
+BTree::Cursor BTree::UpperBound(ObjPointer const& key) const {
+  return this->bound(key, true);
+}
+
+} // namespace fire::btree
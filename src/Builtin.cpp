@@ -1,11 +1,25 @@
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstring>
 #include <iostream>
 #include <sstream>
+#include <unordered_map>
 
 #include "alert.h"
+#include "Utils.h"
 #include "AST.h"
 #include "Builtin.h"
 #include "Object.h"
 #include "Error.h"
+#include "Format.h"
+#include "IO.h"
+#include "Regex.h"
+#include "BTree.h"
+#include "Kernels.h"
+#include "Random.h"
+#include "Sort.h"
 
 #define define_builtin_func(_Name_)                                                      \
   ObjPointer _Name_([[maybe_unused]] ASTPtr<AST::CallFunc> ast,                          \
@@ -24,52 +38,221 @@ void _expect_type(ASTPtr<AST::CallFunc> ast, ObjVector& args, int index,
                                        args[index]->type.to_string() + "'")();
 }
 
-define_builtin_func(Print) {
-  std::stringstream ss;
+//
+// print(args...)
+// println(args...)
+//
+//  objects are written into stdout buffer directly. (see IO.h)
+//  returns count of written bytes.
+//
+static i64 write_objects(std::string& out, ObjVector const& args) {
+  auto begin = out.length();
 
   for (auto&& obj : args)
-    ss << obj->ToString();
+    obj->AppendTo(out);
+
+  return (i64)(out.length() - begin);
+}
+
+define_builtin_func(Print) {
+  auto& stream = io::out();
 
-  auto str = ss.str();
+  auto len = write_objects(stream.Buffer(), args);
 
-  std::cout << str;
+  stream.Commit();
 
-  return ObjNew<ObjPrimitive>((i64)str.length());
+  return ObjNew<ObjPrimitive>(len);
 }
 
 define_builtin_func(Println) {
-  auto ret =
-      ObjNew<ObjPrimitive>(Print(ast, std::move(args))->As<ObjPrimitive>()->vi + 1);
+  auto& stream = io::out();
 
-  std::cout << std::endl;
+  auto len = write_objects(stream.Buffer(), args);
 
-  return ret;
+  stream.Buffer() += '\n';
+  stream.Commit();
+
+  return ObjNew<ObjPrimitive>(len + 1);
+}
+
+define_builtin_func(Flush) {
+  io::out().Flush();
+
+  return ObjNew<ObjNone>();
+}
+
+// ----------------------------
+//  format(fmt, args...)
+//  printf(fmt, args...)
+//
+//  literal format string is compiled in semantics analysis. (PrepareFormat)
+//
+
+static void PrepareFormat(ASTPtr<AST::CallFunc> ast, Vec<TypeInfo> const& arg_types) {
+  auto fmt_ast = ast->args[0];
+
+  if (fmt_ast->kind != ASTKind::Value)
+    return;
+
+  std::shared_ptr<FormatString> fmt;
+
+  try {
+    fmt = FormatString::Compile(fmt_ast->as_value()->value->As<ObjString>()->View());
+  }
+  catch (FormatError const& e) {
+    throw Error(fmt_ast, "invalid format string: " + e.msg);
+  }
+
+  if (fmt->arg_count != arg_types.size() - 1)
+    throw Error(ast->token, "format string requires " + std::to_string(fmt->arg_count) +
+                                " arguments, but " + std::to_string(arg_types.size() - 1) +
+                                " given");
+
+  for (size_t j = 1; auto&& seg : fmt->segments) {
+    if (!seg.has_arg)
+      continue;
+
+    if (seg.hex && !arg_types[j].equals(TypeKind::Int))
+      throw Error(ast->args[j], "'x' format requires int");
+
+    if (seg.precision >= 0 && !arg_types[j].equals(TypeKind::Float))
+      throw Error(ast->args[j], "precision format requires float");
+
+    j++;
+  }
+
+  ast->format = fmt;
+}
+
+static FormatString const& get_format(ASTPtr<AST::CallFunc> ast, ObjVector& args,
+                                      std::shared_ptr<FormatString>& holder) {
+  if (ast->format)
+    return *ast->format;
+
+  // not literal: compile now
+  try {
+    holder = FormatString::Compile(args[0]->As<ObjString>()->View());
+  }
+  catch (FormatError const& e) {
+    throw Error(ast->args[0], "invalid format string: " + e.msg);
+  }
+
+  if (holder->arg_count != args.size() - 1)
+    throw Error(ast->token, "format string requires " +
+                                std::to_string(holder->arg_count) + " arguments, but " +
+                                std::to_string(args.size() - 1) + " given");
+
+  return *holder;
 }
 
+define_builtin_func(Format) {
+  std::shared_ptr<FormatString> holder;
+  std::u16string out;
+
+  get_format(ast, args, holder).Write(out, args.data() + 1);
+
+  return ObjNew<ObjString>(std::move(out));
+}
+
+define_builtin_func(Printf) {
+  std::shared_ptr<FormatString> holder;
+
+  auto& stream = io::out();
+  auto& out = stream.Buffer();
+  auto begin = out.length();
+
+  get_format(ast, args, holder).Write(out, args.data() + 1);
+
+  auto len = (i64)(out.length() - begin);
+
+  stream.Commit();
+
+  return ObjNew<ObjPrimitive>(len);
+}
+
+//
+// content of file is decoded from mapped memory directly. (see IO.h)
+//
+
+// every line ends with '\n'
 define_builtin_func(Open) {
   expect_type(0, TypeKind::String);
 
+  auto file = io::MappedFile::Open(args[0]->ToString());
+
+  if (!file)
+    return ObjNew<ObjNone>();
+
+  auto view = file->View();
+  auto str = utils::to_u16string(std::string_view((char const*)view.data(), view.size()));
+
+  if (!str.empty() && str.back() != u'\n')
+    str.push_back(u'\n');
+
+  return ObjNew<ObjString>(std::move(str));
+}
+
+define_builtin_func(ReadFileString) {
   auto path = args[0]->ToString();
+  auto file = io::MappedFile::Open(path);
 
-  std::ifstream ifs{path};
+  if (!file)
+    throw Error(ast->args[0], "cannot read file '" + path + "'");
 
-  if (!ifs.is_open())
-    return ObjNew<ObjNone>();
+  auto view = file->View();
+
+  return ObjNew<ObjString>(
+      utils::to_u16string(std::string_view((char const*)view.data(), view.size())));
+}
+
+// bytes referring mapped memory (no copy)
+define_builtin_func(MapFile) {
+  auto path = args[0]->ToString();
+  auto file = io::MappedFile::Open(path);
+
+  if (!file)
+    throw Error(ast->args[0], "cannot read file '" + path + "'");
+
+  auto view = file->View();
+
+  return ObjNew<ObjBytes>(std::move(file), view);
+}
+
+//
+// lines(path)
+//
+//   let r = lines(path);
+//   while r.has_next() { let line = r.next(); ... }
+//
+define_builtin_func(Lines) {
+  auto path = args[0]->ToString();
+  auto reader = io::LineReader::Open(path);
+
+  if (!reader)
+    throw Error(ast->args[0], "cannot open file '" + path + "'");
+
+  return ObjNew<ObjLineReader>(std::move(reader));
+}
+
+define_builtin_func(LineReaderHasNext) {
+  return ObjNew<ObjPrimitive>(!args[0]->As<ObjLineReader>()->reader->AtEnd());
+}
 
-  std::string data;
+define_builtin_func(LineReaderNext) {
+  std::string_view line;
 
-  for (std::string line; std::getline(ifs, line); data += line + '\n')
-    ;
+  if (!args[0]->As<ObjLineReader>()->reader->Next(line))
+    throw Error(ast, "no more lines");
 
-  return ObjNew<ObjString>(data);
+  return ObjNew<ObjString>(utils::to_u16string(line));
 }
 
 define_builtin_func(Substr) {
   auto str = args[0]->As<ObjString>();
   auto pos = args[1]->As<ObjPrimitive>()->vi;
 
-  if (pos < 0 || pos >= (i64)str->Length())
-    Error(ast->args[1], "out of range")();
+  if (pos < 0 || pos > (i64)str->Length())
+    throw Error(ast->args[1], "out of range");
 
   return str->SubString(pos);
 }
@@ -79,53 +262,2194 @@ define_builtin_func(Substr2) {
   auto pos = args[1]->As<ObjPrimitive>()->vi;
   auto len = args[2]->As<ObjPrimitive>()->vi;
 
-  if (pos < 0 || pos >= (i64)str->Length())
-    Error(ast->args[1], "out of range")();
+  if (pos < 0 || pos > (i64)str->Length())
+    throw Error(ast->args[1], "out of range");
 
-  if (pos + len >= (i64)str->Length())
-    Error(ast->args[2], "out of range")();
+  if (len < 0 || pos + len > (i64)str->Length())
+    throw Error(ast->args[2], "out of range");
 
   return str->SubString(pos, len);
 }
 
+//
+// slice(begin, end)  =>  [begin, end)
+// slice(begin)       =>  [begin, length)
+//
+//   string or vector; result refers the storage of self. (no copy)
+//
+define_builtin_func(Slice) {
+  auto self = args[0];
+
+  i64 length = self->is_string()  ? self->As<ObjString>()->Length()
+               : self->is_bytes() ? self->As<ObjBytes>()->Length()
+                                  : self->As<ObjIterable>()->Count();
+
+  auto begin = args[1]->get_vi();
+  auto end = args.size() == 3 ? args[2]->get_vi() : length;
+
+  if (begin < 0 || begin > length)
+    throw Error(ast->args[1], "out of range");
+
+  if (end < begin || end > length)
+    throw Error(ast->args[2], "out of range");
+
+  if (self->is_string())
+    return self->As<ObjString>()->SubString(begin, end - begin);
+
+  if (self->is_bytes())
+    return self->As<ObjBytes>()->Slice(begin, end - begin);
+
+  return self->As<ObjIterable>()->Slice(begin, end);
+}
+
 define_builtin_func(Length) {
   auto content = args[0];
 
-  if (content->is_string() || content->is_vector()) {
-    return ObjNew<ObjPrimitive>((i64)content->As<ObjString>()->list.size());
-  }
+  if (content->is_string())
+    return ObjNew<ObjPrimitive>((i64)content->As<ObjString>()->Length());
+
+  if (content->is_vector())
+    return ObjNew<ObjPrimitive>((i64)content->As<ObjIterable>()->Count());
+
+  if (content->is_bytes())
+    return ObjNew<ObjPrimitive>((i64)content->As<ObjBytes>()->Length());
+
+  if (content->is_dict() || content->is_set())
+    return ObjNew<ObjPrimitive>((i64)content->As<ObjDict>()->Count());
+
+  if (content->is_deque())
+    return ObjNew<ObjPrimitive>((i64)content->As<ObjDeque>()->Count());
+
+  if (content->type.kind == TypeKind::PriorityQueue)
+    return ObjNew<ObjPrimitive>((i64)content->As<ObjPriorityQueue>()->Count());
 
   todo_impl;
 }
 
+define_builtin_func(Intern) {
+  return ObjString::Intern(args[0]->As<ObjString>()->View());
+}
+
+define_builtin_func(StrAppend) {
+  auto& buf = args[0]->As<ObjString>()->GetMutable();
+
+  if (args[1]->is_char())
+    buf.push_back(args[1]->get_vc());
+  else
+    buf.append(args[1]->As<ObjString>()->View());
+
+  return ObjNew<ObjNone>();
+}
+
+// ----------------------------
+//  string methods
+//
+//  args[0] = self
+//  pattern argument is string or char.
+
+static constexpr auto npos = std::u16string_view::npos;
+
+static std::u16string_view get_view(ObjPointer const& obj, char16_t& buf) {
+  if (obj->is_char()) {
+    buf = obj->get_vc();
+    return std::u16string_view(&buf, 1);
+  }
+
+  return obj->As<ObjString>()->View();
+}
+
+define_builtin_func(StrFind) {
+  char16_t c;
+  auto str = args[0]->As<ObjString>()->View();
+  auto pattern = get_view(args[1], c);
+
+  i64 pos = args.size() == 3 ? args[2]->get_vi() : 0;
+
+  if (pos < 0 || pos > (i64)str.length())
+    throw Error(ast->args[2], "out of range");
+
+  auto found = utils::find_u16(str, pattern, pos);
+
+  return ObjNew<ObjPrimitive>(found == npos ? (i64)-1 : (i64)found);
+}
+
+define_builtin_func(StrRFind) {
+  char16_t c;
+  auto found = args[0]->As<ObjString>()->View().rfind(get_view(args[1], c));
+
+  return ObjNew<ObjPrimitive>(found == npos ? (i64)-1 : (i64)found);
+}
+
+define_builtin_func(StrContains) {
+  char16_t c;
+  auto str = args[0]->As<ObjString>()->View();
+
+  return ObjNew<ObjPrimitive>(utils::find_u16(str, get_view(args[1], c)) != npos);
+}
+
+define_builtin_func(StrStartsWith) {
+  char16_t c;
+  return ObjNew<ObjPrimitive>(
+      args[0]->As<ObjString>()->View().starts_with(get_view(args[1], c)));
+}
+
+define_builtin_func(StrEndsWith) {
+  char16_t c;
+  return ObjNew<ObjPrimitive>(
+      args[0]->As<ObjString>()->View().ends_with(get_view(args[1], c)));
+}
+
+define_builtin_func(StrCount) {
+  char16_t c;
+  auto str = args[0]->As<ObjString>()->View();
+  auto pattern = get_view(args[1], c);
+
+  if (pattern.empty())
+    throw Error(ast->args[1], "empty pattern");
+
+  i64 count = 0;
+
+  for (size_t pos = 0; (pos = utils::find_u16(str, pattern, pos)) != npos;
+       pos += pattern.length())
+    count++;
+
+  return ObjNew<ObjPrimitive>(count);
+}
+
+//
+// elements of result are slices of self.
+//
+define_builtin_func(StrSplit) {
+  char16_t c;
+  auto self = args[0]->As<ObjString>();
+  auto str = self->View();
+  auto sep = get_view(args[1], c);
+
+  if (sep.empty())
+    throw Error(ast->args[1], "empty separator");
+
+  auto ret = ObjNew<ObjIterable>(TypeInfo(TypeKind::Vector, {TypeKind::String}));
+
+  size_t begin = 0;
+
+  for (size_t pos; (pos = utils::find_u16(str, sep, begin)) != npos;
+       begin = pos + sep.length())
+    ret->Append(self->SubString(begin, pos - begin));
+
+  ret->Append(self->SubString(begin));
+
+  return ret;
+}
+
+define_builtin_func(StrReplace) {
+  char16_t c1, c2;
+  auto self = args[0]->As<ObjString>();
+  auto str = self->View();
+  auto from = get_view(args[1], c1);
+  auto to = get_view(args[2], c2);
+
+  if (from.empty())
+    throw Error(ast->args[1], "empty pattern");
+
+  auto pos = utils::find_u16(str, from);
+
+  if (pos == npos)
+    return self->Clone();
+
+  std::u16string ret;
+
+  ret.reserve(str.length());
+
+  size_t begin = 0;
+
+  for (; pos != npos; pos = utils::find_u16(str, from, begin)) {
+    ret.append(str.substr(begin, pos - begin));
+    ret.append(to);
+
+    begin = pos + from.length();
+  }
+
+  ret.append(str.substr(begin));
+
+  return ObjNew<ObjString>(std::move(ret));
+}
+
+//
+// remove white spaces at both ends. (result is slice of self)
+//
+define_builtin_func(StrTrim) {
+  auto self = args[0]->As<ObjString>();
+  auto str = self->View();
+
+  auto is_space = [](char16_t c) {
+    return c == u' ' || c == u'\t' || c == u'\n' || c == u'\r' || c == u'\v' ||
+           c == u'\f' || c == 0x3000;
+  };
+
+  size_t begin = 0, end = str.length();
+
+  while (begin < end && is_space(str[begin]))
+    begin++;
+
+  while (begin < end && is_space(str[end - 1]))
+    end--;
+
+  return self->SubString(begin, end - begin);
+}
+
 define_builtin_func(ToString) {
   return ObjNew<ObjString>(args[0]->ToString());
 }
 
-// clang-format off
-static const std::vector<Function> g_builtin_functions = {
+// ----------------------------
+//  vector methods
+//
+//  args[0] = self
 
-  { "print",    Print,     TypeKind::Int, { }, true },
-  { "println",  Println,   TypeKind::Int, { }, true },
+define_builtin_func(Push) {
+  args[0]->As<ObjIterable>()->Append(args[1]);
 
-  { "open",     Open,      TypeKind::String, { TypeKind::String }, },
+  return ObjNew<ObjNone>();
+}
 
+define_builtin_func(Pop) {
+  auto vec = args[0]->As<ObjIterable>();
 
-};
+  if (vec->Count() == 0)
+    throw Error(ast->callee, "pop from empty vector");
 
-static const vector<std::pair<TypeInfo, Function>>
-g_builtin_member_functions = {
-  { // substr(index)
-    TypeKind::String, { "substr", Substr, TypeKind::String, { TypeKind::Int } }
-  },
+  return vec->Pop();
+}
 
-  { // substr(index, len)
-    TypeKind::String, { "substr", Substr2, TypeKind::String, { TypeKind::Int, TypeKind::Int } }
-  },
+define_builtin_func(Insert) {
+  auto vec = args[0]->As<ObjIterable>();
+  auto pos = args[1]->get_vi();
+
+  if (pos < 0 || pos > (i64)vec->Count())
+    throw Error(ast->args[1], "out of range");
+
+  vec->Insert((size_t)pos, args[2]);
+
+  return ObjNew<ObjNone>();
+}
+
+define_builtin_func(Extend) {
+  args[0]->As<ObjIterable>()->AppendList(PtrCast<ObjIterable>(args[1]));
+
+  return ObjNew<ObjNone>();
+}
+
+define_builtin_func(Reserve) {
+  auto n = args[1]->get_vi();
+
+  if (n < 0)
+    throw Error(ast->args[1], "negative capacity");
+
+  args[0]->As<ObjIterable>()->Reserve((size_t)n);
+
+  return ObjNew<ObjNone>();
+}
+
+define_builtin_func(Clear) {
+  args[0]->As<ObjIterable>()->Clear();
+
+  return ObjNew<ObjNone>();
+}
+
+define_builtin_func(Capacity) {
+  return ObjNew<ObjPrimitive>((i64)args[0]->As<ObjIterable>()->Capacity());
+}
+
+// ----------------------------
+//  StringBuilder
+//
+//  args[0] = self
+
+define_builtin_func(NewStringBuilder) {
+  return ObjNew<ObjStringBuilder>();
+}
+
+define_builtin_func(SBAppend) {
+  auto sb = args[0]->As<ObjStringBuilder>();
+  auto obj = args[1];
+
+  if (obj->is_string())
+    sb->Append(obj->As<ObjString>()->View());
+  else if (obj->is_char())
+    sb->Append(obj->get_vc());
+  else
+    sb->Append(utils::to_u16string(obj->ToString()));
+
+  return ObjNew<ObjNone>();
+}
+
+define_builtin_func(SBReserve) {
+  auto n = args[1]->get_vi();
+
+  if (n < 0)
+    throw Error(ast->args[1], "negative capacity");
+
+  args[0]->As<ObjStringBuilder>()->Reserve((size_t)n);
+
+  return ObjNew<ObjNone>();
+}
+
+define_builtin_func(SBLength) {
+  return ObjNew<ObjPrimitive>((i64)args[0]->As<ObjStringBuilder>()->Length());
+}
+
+define_builtin_func(SBClear) {
+  args[0]->As<ObjStringBuilder>()->Clear();
+
+  return ObjNew<ObjNone>();
+}
+
+define_builtin_func(SBBuild) {
+  return args[0]->As<ObjStringBuilder>()->Build();
+}
+
+// ----------------------------
+//  regex
+//
+//  args[0] = self
+
+//
+// regex(pattern)
+//   compiled pattern is cached; compiled once in loop.
+//
+define_builtin_func(NewRegex) {
+  try {
+    return ObjNew<ObjRegex>(regex::get_compiled(args[0]->As<ObjString>()->View()));
+  }
+  catch (regex::PatternError const& e) {
+    throw Error(ast->args[0],
+                "invalid regex: " + e.msg + " (at " + std::to_string(e.pos) + ")");
+  }
+}
+
+define_builtin_func(RegexMatch) {
+  auto& re = *args[0]->As<ObjRegex>()->re;
+
+  return ObjNew<ObjPrimitive>(re.Match(args[1]->As<ObjString>()->View()));
+}
+
+//
+// search(str [, from])  =>  [begin, end] or []
+//
+define_builtin_func(RegexSearch) {
+  auto& re = *args[0]->As<ObjRegex>()->re;
+  auto str = args[1]->As<ObjString>()->View();
+
+  i64 from = args.size() == 3 ? args[2]->get_vi() : 0;
+
+  if (from < 0 || from > (i64)str.length())
+    throw Error(ast->args[2], "out of range");
+
+  auto ret = ObjNew<ObjIterable>(TypeInfo(TypeKind::Vector, {TypeKind::Int}));
+
+  if (size_t begin, end; re.Search(str, from, begin, end)) {
+    ret->Append(ObjNew<ObjPrimitive>((i64)begin));
+    ret->Append(ObjNew<ObjPrimitive>((i64)end));
+  }
+
+  return ret;
+}
+
+//
+// all matched parts. (slices of str)
+//
+define_builtin_func(RegexFindAll) {
+  auto& re = *args[0]->As<ObjRegex>()->re;
+  auto self = args[1]->As<ObjString>();
+  auto str = self->View();
+
+  auto ret = ObjNew<ObjIterable>(TypeInfo(TypeKind::Vector, {TypeKind::String}));
+
+  for (size_t pos = 0, begin, end; pos <= str.length() && re.Search(str, pos, begin, end);) {
+    ret->Append(self->SubString(begin, end - begin));
+
+    // empty match: advance one
+    pos = end == begin ? end + 1 : end;
+  }
+
+  return ret;
+}
+
+define_builtin_func(RegexReplace) {
+  auto& re = *args[0]->As<ObjRegex>()->re;
+  auto str = args[1]->As<ObjString>()->View();
+  auto to = args[2]->As<ObjString>()->View();
+
+  std::u16string ret;
+
+  ret.reserve(str.length());
+
+  size_t pos = 0;
+
+  for (size_t begin, end; pos <= str.length() && re.Search(str, pos, begin, end);) {
+    ret.append(str.substr(pos, begin - pos));
+    ret.append(to);
+
+    if (begin == end) {
+      if (end < str.length())
+        ret.push_back(str[end]);
+
+      end++;
+    }
+
+    pos = end;
+  }
+
+  if (pos < str.length())
+    ret.append(str.substr(pos));
+
+  return ObjNew<ObjString>(std::move(ret));
+}
+
+// ----------------------------
+//  dict<K, V>
+//
+
+define_builtin_func(DictContains) {
+  return ObjNew<ObjPrimitive>(args[0]->As<ObjDict>()->Find(args[1]) != nullptr);
+}
+
+// get(key, default)
+define_builtin_func(DictGet) {
+  if (auto value = args[0]->As<ObjDict>()->Find(args[1]))
+    return *value;
+
+  return args[2];
+}
+
+define_builtin_func(DictRemove) {
+  return ObjNew<ObjPrimitive>(args[0]->As<ObjDict>()->Remove(args[1]));
+}
+
+define_builtin_func(DictReserve) {
+  auto n = args[1]->get_vi();
+
+  if (n < 0)
+    throw Error(ast->args[1], "negative capacity");
+
+  args[0]->As<ObjDict>()->Reserve((size_t)n);
+
+  return ObjNew<ObjNone>();
+}
+
+define_builtin_func(DictClear) {
+  args[0]->As<ObjDict>()->Clear();
+
+  return ObjNew<ObjNone>();
+}
+
+// keys in order of insertion
+define_builtin_func(DictKeys) {
+  auto dict = args[0]->As<ObjDict>();
+  auto ret = ObjNew<ObjIterable>(TypeInfo(TypeKind::Vector, {dict->type.params[0]}));
+
+  ret->Reserve(dict->Count());
+
+  dict->ForEach([&ret](ObjPointer const& k, ObjPointer const&) {
+    ret->Append(ObjIterable::CopyElement(k));
+  });
+
+  return ret;
+}
+
+define_builtin_func(DictValues) {
+  auto dict = args[0]->As<ObjDict>();
+  auto ret = ObjNew<ObjIterable>(TypeInfo(TypeKind::Vector, {dict->type.params[1]}));
+
+  ret->Reserve(dict->Count());
+
+  dict->ForEach([&ret](ObjPointer const&, ObjPointer const& v) {
+    ret->Append(v);
+  });
+
+  return ret;
+}
+
+// ----------------------------
+//  ordered_map<K, V>
+//
+//  lower_bound / upper_bound returns [key] or [] (not found).
+//  range(lo, hi) returns keys in [lo, hi).
+//
+
+static btree::BTree const& get_tree(ObjPointer const& obj) {
+  return obj->As<ObjOrderedMap>()->Get();
+}
+
+static ObjPtr<ObjIterable> make_vector_of(TypeInfo const& elem) {
+  return ObjNew<ObjIterable>(TypeInfo(TypeKind::Vector, {elem}));
+}
+
+define_builtin_func(OMapContains) {
+  return ObjNew<ObjPrimitive>(get_tree(args[0]).Find(args[1]) != nullptr);
+}
+
+define_builtin_func(OMapGet) {
+  if (auto value = get_tree(args[0]).Find(args[1]))
+    return *value;
+
+  return args[2];
+}
+
+define_builtin_func(OMapRemove) {
+  auto map = args[0]->As<ObjOrderedMap>();
+
+  if (!map->Get().Find(args[1]))
+    return ObjNew<ObjPrimitive>(false);
+
+  return ObjNew<ObjPrimitive>(map->GetMutable().Remove(args[1]));
+}
+
+define_builtin_func(OMapClear) {
+  args[0]->As<ObjOrderedMap>()->GetMutable().Clear();
+
+  return ObjNew<ObjNone>();
+}
+
+define_builtin_func(OMapLength) {
+  return ObjNew<ObjPrimitive>((i64)get_tree(args[0]).Count());
+}
+
+define_builtin_func(OMapFirst) {
+  auto cur = get_tree(args[0]).Begin();
+
+  if (cur.IsEnd())
+    throw Error(ast, "ordered_map is empty");
+
+  return ObjIterable::CopyElement(cur.GetKey());
+}
+
+define_builtin_func(OMapLast) {
+  auto cur = get_tree(args[0]).Last();
+
+  if (cur.IsEnd())
+    throw Error(ast, "ordered_map is empty");
+
+  return ObjIterable::CopyElement(cur.GetKey());
+}
+
+static ObjPointer bound_to_vector(ObjPointer const& map, btree::BTree::Cursor cur) {
+  auto ret = make_vector_of(map->type.params[0]);
+
+  if (!cur.IsEnd())
+    ret->Append(ObjIterable::CopyElement(cur.GetKey()));
+
+  return ret;
+}
+
+define_builtin_func(OMapLowerBound) {
+  return bound_to_vector(args[0], get_tree(args[0]).LowerBound(args[1]));
+}
+
+define_builtin_func(OMapUpperBound) {
+  return bound_to_vector(args[0], get_tree(args[0]).UpperBound(args[1]));
+}
+
+//
+// keys or values in [lo, hi).
+//   without range, all entries.
+template <bool Values>
+static ObjPointer omap_collect(ObjVector const& args) {
+  auto& tree = get_tree(args[0]);
+  auto ret = make_vector_of(args[0]->type.params[Values ? 1 : 0]);
+
+  if (args.size() >= 3 && tree.Compare(args[1], args[2]) >= 0)
+    return ret;
+
+  auto cur = args.size() >= 2 ? tree.LowerBound(args[1]) : tree.Begin();
+  auto end = args.size() >= 3 ? tree.LowerBound(args[2]) : btree::BTree::Cursor{};
+
+  if (args.size() < 2)
+    ret->Reserve(tree.Count());
+
+  for (; !cur.IsEnd() && (cur.leaf != end.leaf || cur.index != end.index); cur.Next()) {
+    if constexpr (Values)
+      ret->Append(cur.GetValue());
+    else
+      ret->Append(ObjIterable::CopyElement(cur.GetKey()));
+  }
+
+  return ret;
+}
+
+define_builtin_func(OMapKeys) {
+  return omap_collect<false>(args);
+}
+
+define_builtin_func(OMapValues) {
+  return omap_collect<true>(args);
+}
+
+// ----------------------------
+//  set<T>
+//
+//  same table as dict, but values are not used.
+//
+
+define_builtin_func(SetAdd) {
+  return ObjNew<ObjPrimitive>(args[0]->As<ObjSet>()->Add(args[1]));
+}
+
+define_builtin_func(VectorToSet) {
+  auto vec = args[0]->As<ObjIterable>();
+  auto& elem = vec->type.params[0];
+
+  if (!ObjDict::IsHashableType(elem))
+    throw Error(ast, "'" + elem.to_string() + "' type cannot be used as element of set");
+
+  auto ret = ObjNew<ObjSet>(TypeInfo(TypeKind::Set, {elem}));
+
+  ret->Reserve(vec->Count());
+
+  for (size_t i = 0; i < vec->Count(); i++)
+    ret->Add(vec->At(i));
+
+  return ret;
+}
+
+// ----------------------------
+//  bitset
+//
+//  bits are packed into 64-bit words.
+//  loops over words are simple, so compiler can vectorize them.
+//
+
+define_builtin_func(NewBitSet) {
+  auto n = args[0]->get_vi();
+
+  if (n < 0)
+    throw Error(ast->args[0], "negative size");
+
+  return ObjNew<ObjBitSet>((size_t)n);
+}
+
+static size_t bit_index(ASTPtr<AST::CallFunc> ast, ObjBitSet const* bs,
+                        ObjPointer const& index) {
+  auto i = index->get_vi();
+
+  if (i < 0 || (size_t)i >= bs->size)
+    throw Error(ast->args[0], "index out of range");
+
+  return (size_t)i;
+}
+
+define_builtin_func(BitSetSet) {
+  auto bs = args[0]->As<ObjBitSet>();
+
+  bs->Set(bit_index(ast, bs, args[1]), true);
+
+  return ObjNew<ObjNone>();
+}
+
+define_builtin_func(BitSetReset) {
+  auto bs = args[0]->As<ObjBitSet>();
+
+  bs->Set(bit_index(ast, bs, args[1]), false);
+
+  return ObjNew<ObjNone>();
+}
+
+define_builtin_func(BitSetFlip) {
+  auto bs = args[0]->As<ObjBitSet>();
+  auto i = bit_index(ast, bs, args[1]);
+
+  bs->Set(i, !bs->Test(i));
+
+  return ObjNew<ObjNone>();
+}
+
+define_builtin_func(BitSetTest) {
+  auto bs = args[0]->As<ObjBitSet>();
+
+  return ObjNew<ObjPrimitive>(bs->Test(bit_index(ast, bs, args[1])));
+}
+
+define_builtin_func(BitSetCount) {
+  return ObjNew<ObjPrimitive>((i64)args[0]->As<ObjBitSet>()->Count());
+}
+
+define_builtin_func(BitSetSize) {
+  return ObjNew<ObjPrimitive>((i64)args[0]->As<ObjBitSet>()->size);
+}
+
+define_builtin_func(BitSetClear) {
+  auto& words = args[0]->As<ObjBitSet>()->words;
+
+  std::fill(words.begin(), words.end(), 0);
+
+  return ObjNew<ObjNone>();
+}
+
+template <typename F>
+static ObjPointer bitset_combine(ASTPtr<AST::CallFunc> ast, ObjVector const& args, F f) {
+  auto a = args[0]->As<ObjBitSet>();
+  auto b = args[1]->As<ObjBitSet>();
+
+  if (a->size != b->size)
+    throw Error(ast->args[0], "size mismatch: " + std::to_string(a->size) + " and " +
+                                  std::to_string(b->size));
+
+  auto ret = ObjNew<ObjBitSet>(a->size);
+
+  u64 const* x = a->words.data();
+  u64 const* y = b->words.data();
+  u64* out = ret->words.data();
+
+  for (size_t i = 0, n = ret->words.size(); i < n; i++)
+    out[i] = f(x[i], y[i]);
+
+  return ret;
+}
+
+define_builtin_func(BitSetUnion) {
+  return bitset_combine(ast, args, [](u64 x, u64 y) { return x | y; });
+}
+
+define_builtin_func(BitSetIntersect) {
+  return bitset_combine(ast, args, [](u64 x, u64 y) { return x & y; });
+}
+
+define_builtin_func(BitSetDifference) {
+  return bitset_combine(ast, args, [](u64 x, u64 y) { return x & ~y; });
+}
+
+// indices of set bits
+define_builtin_func(BitSetOnes) {
+  auto bs = args[0]->As<ObjBitSet>();
+  auto ret = ObjNew<ObjIterable>(TypeInfo(TypeKind::Vector, {TypeKind::Int}));
+
+  auto& list = ret->GetMutableRaw<i64>();
+
+  list.reserve(bs->Count());
+
+  for (size_t w = 0; w < bs->words.size(); w++) {
+    // 立っているビットだけを順に取り出す
+    for (u64 bits = bs->words[w]; bits; bits &= bits - 1)
+      list.emplace_back((i64)(w * 64 + std::countr_zero(bits)));
+  }
+
+  return ret;
+}
+
+// first set bit at or after index, or -1
+define_builtin_func(BitSetNext) {
+  auto bs = args[0]->As<ObjBitSet>();
+  auto from = args[1]->get_vi();
+
+  if (from < 0)
+    from = 0;
+
+  auto i = bs->FindNext((size_t)from);
+
+  return ObjNew<ObjPrimitive>(i < bs->size ? (i64)i : (i64)-1);
+}
+
+// ----------------------------
+//  deque<T>
+//
+
+define_builtin_func(DequePushBack) {
+  args[0]->As<ObjDeque>()->PushBack(args[1]);
+
+  return ObjNew<ObjNone>();
+}
+
+define_builtin_func(DequePushFront) {
+  args[0]->As<ObjDeque>()->PushFront(args[1]);
+
+  return ObjNew<ObjNone>();
+}
+
+static ObjDeque* non_empty_deque(ASTPtr<AST::CallFunc> ast, ObjPointer const& obj) {
+  auto dq = obj->As<ObjDeque>();
+
+  if (dq->Count() == 0)
+    throw Error(ast->callee, "deque is empty");
+
+  return dq;
+}
+
+define_builtin_func(DequePopBack) {
+  return non_empty_deque(ast, args[0])->PopBack();
+}
+
+define_builtin_func(DequePopFront) {
+  return non_empty_deque(ast, args[0])->PopFront();
+}
+
+define_builtin_func(DequeFront) {
+  return non_empty_deque(ast, args[0])->At(0);
+}
+
+define_builtin_func(DequeBack) {
+  auto dq = non_empty_deque(ast, args[0]);
+
+  return dq->At(dq->Count() - 1);
+}
+
+define_builtin_func(DequeClear) {
+  args[0]->As<ObjDeque>()->Clear();
+
+  return ObjNew<ObjNone>();
+}
+
+// ----------------------------
+//  priority_queue<T>
+//
+//  pop() returns largest element first.
+//  set_reversed(true) makes it smallest first.
+//
+
+define_builtin_func(PQueuePush) {
+  args[0]->As<ObjPriorityQueue>()->Push(args[1]);
+
+  return ObjNew<ObjNone>();
+}
+
+static ObjPriorityQueue* non_empty_pqueue(ASTPtr<AST::CallFunc> ast, ObjPointer const& obj) {
+  auto pq = obj->As<ObjPriorityQueue>();
+
+  if (pq->Count() == 0)
+    throw Error(ast->callee, "priority_queue is empty");
+
+  return pq;
+}
+
+define_builtin_func(PQueuePop) {
+  return non_empty_pqueue(ast, args[0])->Pop();
+}
+
+define_builtin_func(PQueueTop) {
+  return non_empty_pqueue(ast, args[0])->Top();
+}
+
+define_builtin_func(PQueueClear) {
+  args[0]->As<ObjPriorityQueue>()->Clear();
+
+  return ObjNew<ObjNone>();
+}
+
+define_builtin_func(PQueueSetReversed) {
+  args[0]->As<ObjPriorityQueue>()->SetReversed(args[1]->get_vb());
+
+  return ObjNew<ObjNone>();
+}
+
+define_builtin_func(PQueueSorted) {
+  auto pq = args[0]->As<ObjPriorityQueue>();
+  auto ret = ObjNew<ObjIterable>(TypeInfo(TypeKind::Vector, {pq->type.params[0]}));
+
+  for (auto&& e : pq->Sorted())
+    ret->Append(ObjIterable::CopyElement(e));
+
+  return ret;
+}
+
+// ----------------------------
+//  matrix(rows, cols)
+//  matrix(vector<vector<float>>)
+//
+//  dense matrix of float. (see ObjMatrix)
+//
+static ObjPtr<ObjMatrix> new_matrix(ASTPtr<AST::CallFunc> ast, i64 rows, i64 cols) {
+  if (rows < 0 || cols < 0)
+    throw Error(ast->callee, "negative size of matrix");
+
+  return ObjNew<ObjMatrix>((size_t)rows, (size_t)cols);
+}
+
+define_builtin_func(NewMatrix) {
+  return new_matrix(ast, args[0]->get_vi(), args[1]->get_vi());
+}
+
+define_builtin_func(MatrixFromRows) {
+  auto const& rows = args[0]->As<ObjIterable>()->GetList();
+  auto cols = rows.empty() ? 0 : rows[0]->As<ObjIterable>()->Count();
+
+  auto m = new_matrix(ast, (i64)rows.size(), (i64)cols);
+
+  for (size_t i = 0; i < rows.size(); i++) {
+    auto row = rows[i]->As<ObjIterable>()->GetRaw<double>();
+
+    if (row.size() != cols)
+      throw Error(ast->args[0], "length of row " + std::to_string(i) + " is " +
+                                    std::to_string(row.size()) + ", expected " +
+                                    std::to_string(cols));
+
+    std::copy(row.begin(), row.end(), m->data.begin() + i * cols);
+  }
+
+  return m;
+}
+
+define_builtin_func(MatrixRows) {
+  return ObjNew<ObjPrimitive>((i64)args[0]->As<ObjMatrix>()->rows);
+}
+
+define_builtin_func(MatrixCols) {
+  return ObjNew<ObjPrimitive>((i64)args[0]->As<ObjMatrix>()->cols);
+}
+
+// copied by tiles, to avoid cache misses of writing columns
+define_builtin_func(MatrixTranspose) {
+  constexpr size_t tile = 32;
+
+  auto m = args[0]->As<ObjMatrix>();
+  auto t = ObjNew<ObjMatrix>(m->cols, m->rows);
+
+  for (size_t i0 = 0; i0 < m->rows; i0 += tile) {
+    for (size_t j0 = 0; j0 < m->cols; j0 += tile) {
+      for (size_t i = i0; i < std::min(i0 + tile, m->rows); i++)
+        for (size_t j = j0; j < std::min(j0 + tile, m->cols); j++)
+          t->At(j, i) = m->At(i, j);
+    }
+  }
+
+  return t;
+}
+
+define_builtin_func(MatrixMatMul) {
+  auto a = args[0]->As<ObjMatrix>();
+  auto b = args[1]->As<ObjMatrix>();
+
+  if (a->cols != b->rows)
+    throw Error(ast->args[0], "cannot multiply " + std::to_string(a->rows) + "x" +
+                                  std::to_string(a->cols) + " matrix by " +
+                                  std::to_string(b->rows) + "x" +
+                                  std::to_string(b->cols) + " matrix");
+
+  auto c = ObjNew<ObjMatrix>(a->rows, b->cols);
+
+  kernels::MatMul(a->data.data(), b->data.data(), c->data.data(), a->rows, a->cols,
+                  b->cols);
+
+  return c;
+}
+
+define_builtin_func(MatrixMatVec) {
+  auto m = args[0]->As<ObjMatrix>();
+  auto v = args[1]->As<ObjIterable>()->GetRaw<double>();
+
+  if (v.size() != m->cols)
+    throw Error(ast->args[0], "length mismatch: " + std::to_string(m->cols) +
+                                  " columns and " + std::to_string(v.size()));
+
+  auto ret = ObjNew<ObjIterable>(TypeInfo(TypeKind::Vector, {TypeKind::Float}));
+  auto& out = ret->GetMutableRaw<double>();
+
+  out.resize(m->rows);
+
+  for (size_t i = 0; i < m->rows; i++)
+    out[i] = kernels::Dot(m->Row(i), v.data(), m->cols);
+
+  return ret;
+}
+
+define_builtin_func(MatrixRowSums) {
+  auto m = args[0]->As<ObjMatrix>();
+  auto ret = ObjNew<ObjIterable>(TypeInfo(TypeKind::Vector, {TypeKind::Float}));
+  auto& out = ret->GetMutableRaw<double>();
+
+  out.resize(m->rows);
+
+  for (size_t i = 0; i < m->rows; i++)
+    out[i] = kernels::Sum(m->Row(i), m->cols);
+
+  return ret;
+}
+
+// rows are added in order; memory is read sequentially.
+define_builtin_func(MatrixColSums) {
+  auto m = args[0]->As<ObjMatrix>();
+  auto ret = ObjNew<ObjIterable>(TypeInfo(TypeKind::Vector, {TypeKind::Float}));
+  auto& out = ret->GetMutableRaw<double>();
+
+  out.resize(m->cols);
+
+  for (size_t i = 0; i < m->rows; i++)
+    kernels::Add(out.data(), m->Row(i), out.data(), m->cols);
+
+  return ret;
+}
+
+define_builtin_func(MatrixSum) {
+  auto m = args[0]->As<ObjMatrix>();
+
+  return ObjNew<ObjPrimitive>(kernels::Sum(m->data.data(), m->data.size()));
+}
+
+define_builtin_func(MatrixRow) {
+  auto m = args[0]->As<ObjMatrix>();
+  auto i = args[1]->get_vi();
+
+  if (i < 0 || (size_t)i >= m->rows)
+    throw Error(ast->args[0], "row index out of range");
+
+  auto ret = ObjNew<ObjIterable>(TypeInfo(TypeKind::Vector, {TypeKind::Float}));
+
+  ret->GetMutableRaw<double>().assign(m->Row(i), m->Row(i) + m->cols);
+
+  return ret;
+}
+
+define_builtin_func(MatrixFill) {
+  auto m = args[0]->As<ObjMatrix>();
+
+  std::fill(m->data.begin(), m->data.end(), args[1]->get_vf());
+
+  return ObjNew<ObjNone>();
+}
+
+// ----------------------------
+//  math functions
+//
+//  f(float) -> float
+//  f(vector<float>) -> vector<float>   (applied to each element)
+//
+template <double (*Func)(double)>
+define_builtin_func(MathFunc) {
+  return ObjNew<ObjPrimitive>(Func(args[0]->get_vf()));
+}
+
+template <double (*Func)(double)>
+define_builtin_func(MathFuncVec) {
+  auto a = args[0]->As<ObjIterable>()->GetRaw<double>();
+  auto ret = ObjNew<ObjIterable>(args[0]->type);
+  auto& out = ret->GetMutableRaw<double>();
+
+  out.resize(a.size());
+
+  for (size_t i = 0; i < a.size(); i++)
+    out[i] = Func(a[i]);
+
+  return ret;
+}
+
+// vectorized by kernels
+template <void (*Kernel)(double const*, double*, size_t)>
+define_builtin_func(MathKernelVec) {
+  auto a = args[0]->As<ObjIterable>()->GetRaw<double>();
+  auto ret = ObjNew<ObjIterable>(args[0]->type);
+  auto& out = ret->GetMutableRaw<double>();
+
+  out.resize(a.size());
+
+  Kernel(a.data(), out.data(), a.size());
+
+  return ret;
+}
+
+define_builtin_func(MathPow) {
+  return ObjNew<ObjPrimitive>(std::pow(args[0]->get_vf(), args[1]->get_vf()));
+}
+
+define_builtin_func(MathHypot) {
+  return ObjNew<ObjPrimitive>(std::hypot(args[0]->get_vf(), args[1]->get_vf()));
+}
+
+define_builtin_func(MathAtan2) {
+  return ObjNew<ObjPrimitive>(std::atan2(args[0]->get_vf(), args[1]->get_vf()));
+}
+
+define_builtin_func(MathFma) {
+  return ObjNew<ObjPrimitive>(
+      std::fma(args[0]->get_vf(), args[1]->get_vf(), args[2]->get_vf()));
+}
+
+// ----------------------------
+//  random numbers  (see Random.h)
+//
+//  rand_seed(seed)
+//  rand_int(lo, hi)               --> [lo, hi)
+//  rand_float()                   --> [0, 1)
+//  rand_float(lo, hi)             --> [lo, hi)
+//  rand_normal([mean, stddev])
+//  fill_uniform(n, lo, hi)        --> vector<int> or vector<float>
+//  fill_normal(n, mean, stddev)   --> vector<float>
+//
+//  vector<T>.shuffle()
+//  vector<T>.sample(k)            --> k elements at distinct positions
+//
+define_builtin_func(RandSeed) {
+  rng::Get().Seed((u64)args[0]->get_vi());
+
+  return ObjNew<ObjNone>();
+}
+
+static u64 check_int_range(ASTPtr<AST::CallFunc> ast, ObjVector const& args, size_t lo_index) {
+  auto lo = args[lo_index]->get_vi();
+  auto hi = args[lo_index + 1]->get_vi();
+
+  if (hi <= lo)
+    throw Error(ast->args[lo_index], "empty range [" + std::to_string(lo) + ", " +
+                                          std::to_string(hi) + ")");
+
+  return (u64)hi - (u64)lo;
+}
+
+static size_t check_count(ASTPtr<AST::CallFunc> ast, ObjPointer const& obj) {
+  auto n = obj->get_vi();
+
+  if (n < 0)
+    throw Error(ast->args[0], "negative count");
+
+  return (size_t)n;
+}
+
+define_builtin_func(RandInt) {
+  auto range = check_int_range(ast, args, 0);
+
+  return ObjNew<ObjPrimitive>((i64)((u64)args[0]->get_vi() + rng::Get().Bounded(range)));
+}
+
+define_builtin_func(RandFloat) {
+  auto x = rng::Get().NextDouble();
+
+  if (args.empty())
+    return ObjNew<ObjPrimitive>(x);
+
+  auto lo = args[0]->get_vf();
+
+  return ObjNew<ObjPrimitive>(lo + x * (args[1]->get_vf() - lo));
+}
+
+define_builtin_func(RandNormal) {
+  auto x = rng::Get().Normal();
+
+  if (args.empty())
+    return ObjNew<ObjPrimitive>(x);
+
+  return ObjNew<ObjPrimitive>(args[0]->get_vf() + x * args[1]->get_vf());
+}
+
+define_builtin_func(FillUniformInt) {
+  auto n = check_count(ast, args[0]);
+  auto range = check_int_range(ast, args, 1);
+
+  auto ret = ObjNew<ObjIterable>(TypeInfo(TypeKind::Vector, {TypeKind::Int}));
+  auto& out = ret->GetMutableRaw<i64>();
+
+  out.resize(n);
+  rng::Get().FillUniform(out.data(), n, args[1]->get_vi(), range);
+
+  return ret;
+}
+
+define_builtin_func(FillUniformFloat) {
+  auto n = check_count(ast, args[0]);
+
+  auto ret = ObjNew<ObjIterable>(TypeInfo(TypeKind::Vector, {TypeKind::Float}));
+  auto& out = ret->GetMutableRaw<double>();
+
+  out.resize(n);
+  rng::Get().FillUniform(out.data(), n, args[1]->get_vf(), args[2]->get_vf());
+
+  return ret;
+}
+
+define_builtin_func(FillNormal) {
+  auto n = check_count(ast, args[0]);
+
+  auto ret = ObjNew<ObjIterable>(TypeInfo(TypeKind::Vector, {TypeKind::Float}));
+  auto& out = ret->GetMutableRaw<double>();
+
+  out.resize(n);
+  rng::Get().FillNormal(out.data(), n, args[1]->get_vf(), args[2]->get_vf());
+
+  return ret;
+}
+
+// Fisher-Yates
+define_builtin_func(VectorShuffle) {
+  auto& gen = rng::Get();
+
+  args[0]->As<ObjIterable>()->VisitMutable([&gen](auto& list) {
+    for (size_t i = list.size(); i >= 2; i--)
+      std::swap(list[i - 1], list[gen.Bounded(i)]);
+  });
+
+  return ObjNew<ObjNone>();
+}
+
+//
+// first k steps of Fisher-Yates on indices.
+//   (swapped positions are remembered in a map, instead of array of all indices)
+//
+define_builtin_func(VectorSample) {
+  auto self = args[0]->As<ObjIterable>();
+  auto n = self->Count();
+  auto k = args[1]->get_vi();
+
+  if (k < 0 || (size_t)k > n)
+    throw Error(ast->args[0], "cannot take " + std::to_string(k) + " samples from " +
+                                  std::to_string(n) + " elements");
+
+  auto& gen = rng::Get();
+  auto ret = ObjNew<ObjIterable>(self->type);
+
+  std::unordered_map<size_t, size_t> swapped;
+
+  ret->Reserve((size_t)k);
+
+  for (size_t i = 0; i < (size_t)k; i++) {
+    auto j = i + gen.Bounded(n - i);
+
+    auto it_i = swapped.find(i);
+    auto it_j = swapped.find(j);
+
+    auto at_i = it_i == swapped.end() ? i : it_i->second;
+    auto at_j = it_j == swapped.end() ? j : it_j->second;
+
+    swapped[j] = at_i;
+
+    ret->Append(ObjIterable::CopyElement(self->At(at_j)));
+  }
+
+  return ret;
+}
+
+// ----------------------------
+//  vector<T>.sort()
+//  vector<T>.sort_desc()
+//  vector<T>.stable_sort()
+//
+//  T = int, float, char or string.  (see Sort.h)
+//
+static void sort_vector(ObjPointer const& obj, bool stable, bool desc) {
+  auto vec = obj->As<ObjIterable>();
+
+  switch (vec->type.params[0].kind) {
+  case TypeKind::Int: {
+    auto& list = vec->GetMutableRaw<i64>();
+    sort::Sort(list.data(), list.size());
+    break;
+  }
+
+  case TypeKind::Float: {
+    auto& list = vec->GetMutableRaw<double>();
+    sort::Sort(list.data(), list.size());
+    break;
+  }
+
+  case TypeKind::Char: {
+    auto& list = vec->GetMutableRaw<char16_t>();
+
+    if (stable)
+      std::stable_sort(list.begin(), list.end());
+    else
+      sort::Sort(list.data(), list.size());
+
+    break;
+  }
+
+  case TypeKind::String: {
+    auto& list = vec->GetMutableList();
+    sort::SortStrings(list.data(), list.size(), stable);
+    break;
+  }
+  }
+
+  if (desc)
+    vec->VisitMutable([](auto& list) { std::reverse(list.begin(), list.end()); });
+}
+
+define_builtin_func(VectorSort) {
+  sort_vector(args[0], false, false);
+
+  return ObjNew<ObjNone>();
+}
+
+define_builtin_func(VectorSortDesc) {
+  sort_vector(args[0], false, true);
+
+  return ObjNew<ObjNone>();
+}
+
+define_builtin_func(VectorStableSort) {
+  sort_vector(args[0], true, false);
+
+  return ObjNew<ObjNone>();
+}
+
+// ----------------------------
+//  parse_int(str)             parse_float(str)
+//  try_parse_int(str, def)    try_parse_float(str, def)
+//  parse_ints(str [, sep])    parse_floats(str [, sep])
+//
+//  based on std::from_chars.
+//  whole of str (or each field) must be a number, except surrounding spaces.
+//  try_parse_* returns def if str is not a number.
+//
+//  parse_ints / parse_floats read all numbers separated by sep
+//  (or whitespaces if omitted) into a vector.
+//
+
+//
+// narrow UTF-16 to ASCII.
+//   non-ASCII unit is replaced with DEL, that is never a part of number.
+static void narrow_ascii(std::string& out, std::u16string_view str) {
+  out.resize(str.length());
+
+  for (size_t i = 0; i < str.length(); i++)
+    out[i] = str[i] < 0x80 ? (char)str[i] : '\x7f';
+}
+
+static bool is_space(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+template <typename T>
+static bool parse_number(char const* begin, char const* end, T& out) {
+  while (begin < end && is_space(*begin))
+    begin++;
+
+  while (begin < end && is_space(end[-1]))
+    end--;
+
+  if (end - begin >= 2 && *begin == '+' && begin[1] != '-')
+    begin++;
+
+  auto [ptr, ec] = std::from_chars(begin, end, out);
+
+  return ec == std::errc{} && ptr == end && begin < end;
+}
+
+template <typename T>
+static bool parse_number(std::u16string_view str, T& out) {
+  char buf[64];
+
+  // most of numbers are short.
+  if (str.length() <= std::size(buf)) {
+    for (size_t i = 0; i < str.length(); i++)
+      buf[i] = str[i] < 0x80 ? (char)str[i] : '\x7f';
+
+    return parse_number(buf, buf + str.length(), out);
+  }
+
+  std::string tmp;
+
+  narrow_ascii(tmp, str);
+
+  return parse_number(tmp.data(), tmp.data() + tmp.length(), out);
+}
+
+template <typename T>
+static ObjPointer parse_or_throw(ASTPtr<AST::CallFunc> ast, ObjPointer const& str) {
+  T val;
+
+  if (!parse_number(str->As<ObjString>()->View(), val))
+    throw Error(ast->args[0], "invalid number '" + str->ToString() + "'");
+
+  return ObjNew<ObjPrimitive>(val);
+}
+
+template <typename T>
+static ObjPointer try_parse(ObjVector const& args) {
+  T val;
+
+  if (!parse_number(args[0]->As<ObjString>()->View(), val))
+    return args[1]->Clone();
+
+  return ObjNew<ObjPrimitive>(val);
+}
+
+define_builtin_func(ParseInt) {
+  return parse_or_throw<i64>(ast, args[0]);
+}
+
+define_builtin_func(ParseFloat) {
+  return parse_or_throw<double>(ast, args[0]);
+}
+
+define_builtin_func(TryParseInt) {
+  return try_parse<i64>(args);
+}
+
+define_builtin_func(TryParseFloat) {
+  return try_parse<double>(args);
+}
+
+//
+// text is narrowed to ASCII once, then numbers are read from it directly.
+// separators are searched by memchr.
+//
+template <typename T>
+static ObjPointer parse_numbers(ASTPtr<AST::CallFunc> ast, ObjVector const& args,
+                                TypeKind kind) {
+  auto ret = ObjNew<ObjIterable>(TypeInfo(TypeKind::Vector, {kind}));
+
+  std::string text;
+
+  narrow_ascii(text, args[0]->As<ObjString>()->View());
+
+  char const* p = text.data();
+  char const* end = p + text.length();
+
+  auto& list = ret->GetMutableRaw<T>();
+  size_t index = 0;
+
+  auto fail = [&]() {
+    throw Error(ast->args[0], "invalid number at field " + std::to_string(index));
+  };
+
+  T val;
+
+  // separated by whitespaces
+  if (args.size() == 1) {
+    list.reserve(text.length() / 4);
+
+    while (true) {
+      while (p < end && is_space(*p))
+        p++;
+
+      if (p == end)
+        break;
+
+      if (end - p >= 2 && *p == '+' && p[1] != '-')
+        p++;
+
+      auto r = std::from_chars(p, end, val);
+
+      if (r.ec != std::errc{} || (r.ptr < end && !is_space(*r.ptr)))
+        fail();
+
+      list.emplace_back(val);
+
+      p = r.ptr;
+      index++;
+    }
+
+    return ret;
+  }
+
+  auto c = args[1]->get_vc();
+  char sep = c < 0x80 ? (char)c : '\x7f';
+
+  if (text.empty())
+    return ret;
+
+  while (true) {
+    auto next = (char const*)std::memchr(p, sep, end - p);
+    auto field_end = next ? next : end;
+
+    if (!parse_number(p, field_end, val)) {
+      // allow separator (and spaces) at end of text
+      if (!next && std::all_of(p, end, is_space))
+        break;
+
+      fail();
+    }
+
+    list.emplace_back(val);
+    index++;
+
+    if (!next)
+      break;
+
+    p = next + 1;
+  }
+
+  return ret;
+}
+
+define_builtin_func(ParseInts) {
+  return parse_numbers<i64>(ast, args, TypeKind::Int);
+}
+
+define_builtin_func(ParseFloats) {
+  return parse_numbers<double>(ast, args, TypeKind::Float);
+}
+
+//
+// numeric methods of vector<int> and vector<float>.
+//  computed by kernels on the unboxed array. (see Kernels.h)
+//
+template <typename T>
+static T get_scalar(ObjPointer const& obj) {
+  if constexpr (std::is_same_v<T, i64>)
+    return obj->get_vi();
+  else
+    return obj->get_vf();
+}
+
+template <typename T>
+static std::span<T const> non_empty_raw(ASTPtr<AST::CallFunc> ast, ObjPointer const& obj) {
+  auto raw = obj->As<ObjIterable>()->GetRaw<T>();
+
+  if (raw.empty())
+    throw Error(ast->callee, "vector is empty");
+
+  return raw;
+}
+
+template <typename T>
+static std::span<T const> same_length_raw(ASTPtr<AST::CallFunc> ast,
+                                          ObjVector const& args) {
+  auto a = args[0]->As<ObjIterable>()->GetRaw<T>();
+  auto b = args[1]->As<ObjIterable>()->GetRaw<T>();
+
+  if (a.size() != b.size())
+    throw Error(ast->args[0], "length mismatch: " + std::to_string(a.size()) +
+                                  " and " + std::to_string(b.size()));
+
+  return b;
+}
+
+// new vector which has same type and length as args[0]
+template <typename T>
+static std::pair<ObjPtr<ObjIterable>, T*> new_raw_like(ObjPointer const& obj) {
+  auto ret = ObjNew<ObjIterable>(obj->type);
+  auto& list = ret->GetMutableRaw<T>();
+
+  list.resize(obj->As<ObjIterable>()->Count());
+
+  return {ret, list.data()};
+}
+
+template <typename T>
+define_builtin_func(VecSum) {
+  auto a = args[0]->As<ObjIterable>()->GetRaw<T>();
+
+  return ObjNew<ObjPrimitive>(kernels::Sum(a.data(), a.size()));
+}
+
+template <typename T>
+define_builtin_func(VecMin) {
+  auto a = non_empty_raw<T>(ast, args[0]);
+
+  return ObjNew<ObjPrimitive>(kernels::Min(a.data(), a.size()));
+}
+
+template <typename T>
+define_builtin_func(VecMax) {
+  auto a = non_empty_raw<T>(ast, args[0]);
+
+  return ObjNew<ObjPrimitive>(kernels::Max(a.data(), a.size()));
+}
+
+template <typename T>
+define_builtin_func(VecMean) {
+  auto a = non_empty_raw<T>(ast, args[0]);
+
+  return ObjNew<ObjPrimitive>((double)kernels::Sum(a.data(), a.size()) / (double)a.size());
+}
+
+template <typename T>
+define_builtin_func(VecArgMax) {
+  auto a = non_empty_raw<T>(ast, args[0]);
+
+  return ObjNew<ObjPrimitive>((i64)kernels::ArgMax(a.data(), a.size()));
+}
+
+template <typename T>
+define_builtin_func(VecDot) {
+  auto a = args[0]->As<ObjIterable>()->GetRaw<T>();
+  auto b = same_length_raw<T>(ast, args);
+
+  return ObjNew<ObjPrimitive>(kernels::Dot(a.data(), b.data(), a.size()));
+}
+
+template <typename T, void (*Kernel)(T const*, T const*, T*, size_t)>
+define_builtin_func(VecElementwise) {
+  auto b = same_length_raw<T>(ast, args);
+  auto [ret, out] = new_raw_like<T>(args[0]);
+
+  Kernel(args[0]->As<ObjIterable>()->GetRaw<T>().data(), b.data(), out, b.size());
+
+  return ret;
+}
+
+template <typename T>
+define_builtin_func(VecScale) {
+  auto a = args[0]->As<ObjIterable>()->GetRaw<T>();
+  auto [ret, out] = new_raw_like<T>(args[0]);
+
+  kernels::Scale(a.data(), get_scalar<T>(args[1]), out, a.size());
+
+  return ret;
+}
+
+template <typename T>
+define_builtin_func(VecClamp) {
+  auto a = args[0]->As<ObjIterable>()->GetRaw<T>();
+  auto lo = get_scalar<T>(args[1]);
+  auto hi = get_scalar<T>(args[2]);
+
+  if (hi < lo)
+    throw Error(ast->args[1], "lower bound is greater than upper bound");
+
+  auto [ret, out] = new_raw_like<T>(args[0]);
+
+  kernels::Clamp(a.data(), lo, hi, out, a.size());
+
+  return ret;
+}
+
+template <typename T>
+define_builtin_func(VecCumSum) {
+  auto a = args[0]->As<ObjIterable>()->GetRaw<T>();
+  auto [ret, out] = new_raw_like<T>(args[0]);
+
+  kernels::CumSum(a.data(), out, a.size());
+
+  return ret;
+}
+
+//
+// i8(int) .. u64(int)
+//   はみ出した値は型の幅に丸める
+//
+template <TypeKind Kind>
+define_builtin_func(ToFixedInt) {
+  return ObjNew<ObjPrimitive>(Kind, args[0]->get_vi());
+}
+
+// u64 は 2^63 以上が負になる
+define_builtin_func(FixedIntToInt) {
+  return ObjNew<ObjPrimitive>(args[0]->as_primitive()->vi);
+}
+
+// ----------------------------
+//  bytes
+//
+//  bytes(int)          filled with 0
+//  bytes(string)       UTF-8
+//  bytes(vector<u8>)
+//
+define_builtin_func(NewBytes) {
+  if (args[0]->is_int()) {
+    auto n = args[0]->get_vi();
+
+    if (n < 0)
+      throw Error(ast->args[0], "size must not be negative");
+
+    return ObjNew<ObjBytes>(Vec<u8>(n));
+  }
+
+  if (args[0]->is_string()) {
+    string s;
+
+    utils::append_u8string(s, args[0]->As<ObjString>()->View());
+
+    return ObjNew<ObjBytes>(Vec<u8>(s.begin(), s.end()));
+  }
+
+  auto v = args[0]->As<ObjIterable>()->GetRaw<u8>();
+
+  return ObjNew<ObjBytes>(Vec<u8>(v.begin(), v.end()));
+}
+
+define_builtin_func(ReadBytes) {
+  auto path = args[0]->ToString();
+
+  Vec<u8> data;
+
+  if (!io::ReadFile(path, data))
+    throw Error(ast->args[0], "cannot read file '" + path + "'");
+
+  return ObjNew<ObjBytes>(std::move(data));
+}
+
+define_builtin_func(WriteBytes) {
+  auto path = args[0]->ToString();
+
+  if (!io::WriteFile(path, args[1]->As<ObjBytes>()->View()))
+    throw Error(ast->args[0], "cannot write file '" + path + "'");
+
+  return ObjNew<ObjNone>();
+}
+
+//
+// value of T at offset, in little or big endian.
+//   (unaligned; compiled to a load and a byte swap)
+//
+template <typename T>
+using bits_of = std::conditional_t<
+    sizeof(T) == 1, u8,
+    std::conditional_t<sizeof(T) == 2, u16, std::conditional_t<sizeof(T) == 4, u32, u64>>>;
+
+template <typename T, bool BigEndian>
+static bits_of<T> to_endian(bits_of<T> u) {
+  if constexpr (BigEndian != (std::endian::native == std::endian::big)) {
+    if constexpr (sizeof(T) == 2)
+      return __builtin_bswap16(u);
+    else if constexpr (sizeof(T) == 4)
+      return __builtin_bswap32(u);
+    else if constexpr (sizeof(T) == 8)
+      return __builtin_bswap64(u);
+  }
+
+  return u;
+}
+
+template <typename T, bool BigEndian>
+static T load_endian(u8 const* p) {
+  bits_of<T> u;
+
+  std::memcpy(&u, p, sizeof(u));
+
+  return std::bit_cast<T>(to_endian<T, BigEndian>(u));
+}
+
+template <typename T, bool BigEndian>
+static void store_endian(u8* p, T v) {
+  auto u = to_endian<T, BigEndian>(std::bit_cast<bits_of<T>>(v));
+
+  std::memcpy(p, &u, sizeof(u));
+}
+
+static size_t check_bytes_offset(ASTPtr<AST::CallFunc> ast, ObjVector& args, size_t width) {
+  auto offset = args[1]->get_vi();
+
+  if (offset < 0 || (u64)offset + width > args[0]->As<ObjBytes>()->Length())
+    throw Error(ast->args[1], "out of range");
+
+  return (size_t)offset;
+}
+
+//
+// read_u8(offset), read_i32_le(offset), read_f64_be(offset), ...
+//   result is int, or u64 or float.
+//
+template <typename T, bool BigEndian = false>
+define_builtin_func(BytesRead) {
+  auto offset = check_bytes_offset(ast, args, sizeof(T));
+  auto v = load_endian<T, BigEndian>(args[0]->As<ObjBytes>()->Data() + offset);
+
+  if constexpr (std::is_floating_point_v<T>)
+    return ObjNew<ObjPrimitive>((double)v);
+  else if constexpr (std::is_same_v<T, u64>)
+    return ObjNew<ObjPrimitive>(TypeKind::U64, (i64)v);
+  else
+    return ObjNew<ObjPrimitive>((i64)v);
+}
+
+//
+// write_u16_le(offset, value), ...
+//   value is truncated to the width.
+//
+template <typename T, bool BigEndian = false>
+define_builtin_func(BytesWrite) {
+  auto offset = check_bytes_offset(ast, args, sizeof(T));
+
+  T v;
+
+  if constexpr (std::is_floating_point_v<T>)
+    v = (T)args[2]->get_vf();
+  else
+    v = (T)args[2]->as_primitive()->vi;
+
+  store_endian<T, BigEndian>(args[0]->As<ObjBytes>()->GetMutable().data() + offset, v);
+
+  return ObjNew<ObjNone>();
+}
+
+define_builtin_func(BytesAppend) {
+  auto& buf = args[0]->As<ObjBytes>()->GetMutable();
+  auto v = args[1]->As<ObjBytes>()->View();
+
+  buf.insert(buf.end(), v.begin(), v.end());
+
+  return ObjNew<ObjNone>();
+}
+
+// UTF-8 --> string
+define_builtin_func(BytesDecode) {
+  auto v = args[0]->As<ObjBytes>()->View();
+
+  return ObjNew<ObjString>(
+      utils::to_u16string(std::string_view((char const*)v.data(), v.size())));
+}
+
+define_builtin_func(BytesHex) {
+  static constexpr char digits[] = "0123456789abcdef";
+
+  auto v = args[0]->As<ObjBytes>()->View();
+
+  std::u16string s(v.size() * 2, 0);
+
+  for (size_t i = 0; i < v.size(); i++) {
+    s[i * 2] = digits[v[i] >> 4];
+    s[i * 2 + 1] = digits[v[i] & 15];
+  }
+
+  return ObjNew<ObjString>(std::move(s));
+}
+
+define_builtin_func(BytesToVector) {
+  auto v = args[0]->As<ObjBytes>()->View();
+  auto ret = ObjNew<ObjIterable>(TypeInfo(TypeKind::Vector, {TypeKind::U8}));
+
+  ret->GetMutableRaw<u8>().assign(v.begin(), v.end());
+
+  return ret;
+}
+
+//
+// template parameters of builtin types
+//
+static const TypeInfo _T = TypeInfo::make_template_param("T");
+
+static const TypeInfo _Vector = { TypeKind::Vector, { _T } };
+
+static const TypeInfo _StrVector = { TypeKind::Vector, { TypeKind::String } };
+static const TypeInfo _IntVector = { TypeKind::Vector, { TypeKind::Int } };
+static const TypeInfo _FloatVector = { TypeKind::Vector, { TypeKind::Float } };
+static const TypeInfo _CharVector = { TypeKind::Vector, { TypeKind::Char } };
+
+static const TypeInfo _K = TypeInfo::make_template_param("K");
+static const TypeInfo _V = TypeInfo::make_template_param("V");
+
+static const TypeInfo _Dict = { TypeKind::Dict, { _K, _V } };
+static const TypeInfo _OrderedMap = { TypeKind::OrderedMap, { _K, _V } };
+
+static const TypeInfo _Set = { TypeKind::Set, { _T } };
+static const TypeInfo _Deque = { TypeKind::Deque, { _T } };
+static const TypeInfo _PQueue = { TypeKind::PriorityQueue, { _T } };
+
+static const TypeInfo _KVector = { TypeKind::Vector, { _K } };
+static const TypeInfo _VVector = { TypeKind::Vector, { _V } };
+
+static const TypeInfo _FloatRows = { TypeKind::Vector, { _FloatVector } };
+
+static const TypeInfo _U8Vector = { TypeKind::Vector, { TypeKind::U8 } };
+
+// clang-format off
+static const std::vector<Function> g_builtin_functions = {
+
+  { "print",    Print,     TypeKind::Int, { }, true },
+  { "println",  Println,   TypeKind::Int, { }, true },
+  { "flush",    Flush,     TypeKind::None, { }, },
+
+  { "format",   Format,    TypeKind::String, { TypeKind::String }, true, PrepareFormat },
+  { "printf",   Printf,    TypeKind::Int,    { TypeKind::String }, true, PrepareFormat },
+
+  { "open",      Open,           TypeKind::String,     { TypeKind::String }, },
+  { "read_file", ReadFileString, TypeKind::String,     { TypeKind::String }, },
+  { "map_file",  MapFile,        TypeKind::Bytes,      { TypeKind::String }, },
+  { "lines",     Lines,          TypeKind::LineReader, { TypeKind::String }, },
+
+  { "StringBuilder", NewStringBuilder, TypeKind::StringBuilder, { }, },
+
+  { "regex",    NewRegex,  TypeKind::Regex, { TypeKind::String }, },
+
+  { "bitset",   NewBitSet, TypeKind::BitSet, { TypeKind::Int }, },
+
+  { "matrix",   NewMatrix,      TypeKind::Matrix, { TypeKind::Int, TypeKind::Int }, },
+  { "matrix",   MatrixFromRows, TypeKind::Matrix, { _FloatRows }, },
+
+  { "parse_int",       ParseInt,      TypeKind::Int,   { TypeKind::String }, },
+  { "parse_float",     ParseFloat,    TypeKind::Float, { TypeKind::String }, },
+  { "try_parse_int",   TryParseInt,   TypeKind::Int,   { TypeKind::String, TypeKind::Int }, },
+  { "try_parse_float", TryParseFloat, TypeKind::Float, { TypeKind::String, TypeKind::Float }, },
+  { "parse_ints",      ParseInts,     _IntVector,      { TypeKind::String }, },
+  { "parse_ints",      ParseInts,     _IntVector,      { TypeKind::String, TypeKind::Char }, },
+  { "parse_floats",    ParseFloats,   _FloatVector,    { TypeKind::String }, },
+  { "parse_floats",    ParseFloats,   _FloatVector,    { TypeKind::String, TypeKind::Char }, },
+
+  { "sqrt",  MathFunc<std::sqrt>,          TypeKind::Float, { TypeKind::Float }, },
+  { "sqrt",  MathFuncVec<std::sqrt>,       _FloatVector,    { _FloatVector }, },
+  { "cbrt",  MathFunc<std::cbrt>,          TypeKind::Float, { TypeKind::Float }, },
+  { "cbrt",  MathFuncVec<std::cbrt>,       _FloatVector,    { _FloatVector }, },
+  { "exp",   MathFunc<std::exp>,           TypeKind::Float, { TypeKind::Float }, },
+  { "exp",   MathKernelVec<kernels::Exp>,  _FloatVector,    { _FloatVector }, },
+  { "log",   MathFunc<std::log>,           TypeKind::Float, { TypeKind::Float }, },
+  { "log",   MathKernelVec<kernels::Log>,  _FloatVector,    { _FloatVector }, },
+  { "log2",  MathFunc<std::log2>,          TypeKind::Float, { TypeKind::Float }, },
+  { "log2",  MathFuncVec<std::log2>,       _FloatVector,    { _FloatVector }, },
+  { "log10", MathFunc<std::log10>,         TypeKind::Float, { TypeKind::Float }, },
+  { "log10", MathFuncVec<std::log10>,      _FloatVector,    { _FloatVector }, },
+  { "sin",   MathFunc<std::sin>,           TypeKind::Float, { TypeKind::Float }, },
+  { "sin",   MathKernelVec<kernels::Sin>,  _FloatVector,    { _FloatVector }, },
+  { "cos",   MathFunc<std::cos>,           TypeKind::Float, { TypeKind::Float }, },
+  { "cos",   MathKernelVec<kernels::Cos>,  _FloatVector,    { _FloatVector }, },
+  { "tan",   MathFunc<std::tan>,           TypeKind::Float, { TypeKind::Float }, },
+  { "tan",   MathFuncVec<std::tan>,        _FloatVector,    { _FloatVector }, },
+  { "asin",  MathFunc<std::asin>,          TypeKind::Float, { TypeKind::Float }, },
+  { "asin",  MathFuncVec<std::asin>,       _FloatVector,    { _FloatVector }, },
+  { "acos",  MathFunc<std::acos>,          TypeKind::Float, { TypeKind::Float }, },
+  { "acos",  MathFuncVec<std::acos>,       _FloatVector,    { _FloatVector }, },
+  { "atan",  MathFunc<std::atan>,          TypeKind::Float, { TypeKind::Float }, },
+  { "atan",  MathFuncVec<std::atan>,       _FloatVector,    { _FloatVector }, },
+  { "floor", MathFunc<std::floor>,         TypeKind::Float, { TypeKind::Float }, },
+  { "floor", MathFuncVec<std::floor>,      _FloatVector,    { _FloatVector }, },
+  { "ceil",  MathFunc<std::ceil>,          TypeKind::Float, { TypeKind::Float }, },
+  { "ceil",  MathFuncVec<std::ceil>,       _FloatVector,    { _FloatVector }, },
+  { "round", MathFunc<std::round>,         TypeKind::Float, { TypeKind::Float }, },
+  { "round", MathFuncVec<std::round>,      _FloatVector,    { _FloatVector }, },
+  { "trunc", MathFunc<std::trunc>,         TypeKind::Float, { TypeKind::Float }, },
+  { "trunc", MathFuncVec<std::trunc>,      _FloatVector,    { _FloatVector }, },
+  { "abs",   MathFunc<std::fabs>,          TypeKind::Float, { TypeKind::Float }, },
+  { "abs",   MathFuncVec<std::fabs>,       _FloatVector,    { _FloatVector }, },
+
+  { "pow",    MathPow,   TypeKind::Float, { TypeKind::Float, TypeKind::Float }, },
+  { "hypot",  MathHypot, TypeKind::Float, { TypeKind::Float, TypeKind::Float }, },
+  { "atan2",  MathAtan2, TypeKind::Float, { TypeKind::Float, TypeKind::Float }, },
+  { "fma",    MathFma,   TypeKind::Float, { TypeKind::Float, TypeKind::Float, TypeKind::Float }, },
+
+  { "rand_seed",    RandSeed,         TypeKind::None,  { TypeKind::Int }, },
+  { "rand_int",     RandInt,          TypeKind::Int,   { TypeKind::Int, TypeKind::Int }, },
+  { "rand_float",   RandFloat,        TypeKind::Float, { }, },
+  { "rand_float",   RandFloat,        TypeKind::Float, { TypeKind::Float, TypeKind::Float }, },
+  { "rand_normal",  RandNormal,       TypeKind::Float, { }, },
+  { "rand_normal",  RandNormal,       TypeKind::Float, { TypeKind::Float, TypeKind::Float }, },
+  { "fill_uniform", FillUniformInt,   _IntVector,      { TypeKind::Int, TypeKind::Int, TypeKind::Int }, },
+  { "fill_uniform", FillUniformFloat, _FloatVector,    { TypeKind::Int, TypeKind::Float, TypeKind::Float }, },
+  { "fill_normal",  FillNormal,       _FloatVector,    { TypeKind::Int, TypeKind::Float, TypeKind::Float }, },
+
+  { "i8",  ToFixedInt<TypeKind::I8>,  TypeKind::I8,  { TypeKind::Int }, },
+  { "i16", ToFixedInt<TypeKind::I16>, TypeKind::I16, { TypeKind::Int }, },
+  { "i32", ToFixedInt<TypeKind::I32>, TypeKind::I32, { TypeKind::Int }, },
+  { "u8",  ToFixedInt<TypeKind::U8>,  TypeKind::U8,  { TypeKind::Int }, },
+  { "u16", ToFixedInt<TypeKind::U16>, TypeKind::U16, { TypeKind::Int }, },
+  { "u32", ToFixedInt<TypeKind::U32>, TypeKind::U32, { TypeKind::Int }, },
+  { "u64", ToFixedInt<TypeKind::U64>, TypeKind::U64, { TypeKind::Int }, },
+
+  { "bytes",       NewBytes,   TypeKind::Bytes, { TypeKind::Int }, },
+  { "bytes",       NewBytes,   TypeKind::Bytes, { TypeKind::String }, },
+  { "bytes",       NewBytes,   TypeKind::Bytes, { _U8Vector }, },
+  { "read_bytes",  ReadBytes,  TypeKind::Bytes, { TypeKind::String }, },
+  { "write_bytes", WriteBytes, TypeKind::None,  { TypeKind::String, TypeKind::Bytes }, },
+
+
+};
+
+
+static const vector<std::pair<TypeInfo, Function>>
+g_builtin_member_functions = {
+  { // substr(index)
+    TypeKind::String, { "substr", Substr, TypeKind::String, { TypeKind::Int } }
+  },
+
+  { // substr(index, len)
+    TypeKind::String, { "substr", Substr2, TypeKind::String, { TypeKind::Int, TypeKind::Int } }
+  },
+
+  { TypeKind::String, { "slice",  Slice,  TypeKind::String, { TypeKind::Int }, } },
+  { TypeKind::String, { "slice",  Slice,  TypeKind::String, { TypeKind::Int, TypeKind::Int }, } },
+  { TypeKind::String, { "length", Length, TypeKind::Int, { }, } },
+
+  { TypeKind::String, { "find",        StrFind,       TypeKind::Int,  { TypeKind::String }, } },
+  { TypeKind::String, { "find",        StrFind,       TypeKind::Int,  { TypeKind::Char }, } },
+  { TypeKind::String, { "find",        StrFind,       TypeKind::Int,  { TypeKind::String, TypeKind::Int }, } },
+  { TypeKind::String, { "find",        StrFind,       TypeKind::Int,  { TypeKind::Char, TypeKind::Int }, } },
+  { TypeKind::String, { "rfind",       StrRFind,      TypeKind::Int,  { TypeKind::String }, } },
+  { TypeKind::String, { "rfind",       StrRFind,      TypeKind::Int,  { TypeKind::Char }, } },
+  { TypeKind::String, { "contains",    StrContains,   TypeKind::Bool, { TypeKind::String }, } },
+  { TypeKind::String, { "contains",    StrContains,   TypeKind::Bool, { TypeKind::Char }, } },
+  { TypeKind::String, { "starts_with", StrStartsWith, TypeKind::Bool, { TypeKind::String }, } },
+  { TypeKind::String, { "starts_with", StrStartsWith, TypeKind::Bool, { TypeKind::Char }, } },
+  { TypeKind::String, { "ends_with",   StrEndsWith,   TypeKind::Bool, { TypeKind::String }, } },
+  { TypeKind::String, { "ends_with",   StrEndsWith,   TypeKind::Bool, { TypeKind::Char }, } },
+  { TypeKind::String, { "count",       StrCount,      TypeKind::Int,  { TypeKind::String }, } },
+  { TypeKind::String, { "count",       StrCount,      TypeKind::Int,  { TypeKind::Char }, } },
+  { TypeKind::String, { "split",       StrSplit,      _StrVector,     { TypeKind::String }, } },
+  { TypeKind::String, { "split",       StrSplit,      _StrVector,     { TypeKind::Char }, } },
+  { TypeKind::String, { "replace",     StrReplace,    TypeKind::String, { TypeKind::String, TypeKind::String }, } },
+  { TypeKind::String, { "replace",     StrReplace,    TypeKind::String, { TypeKind::Char, TypeKind::Char }, } },
+  { TypeKind::String, { "trim",        StrTrim,       TypeKind::String, { }, } },
+  { TypeKind::String, { "intern", Intern, TypeKind::String, { }, } },
+  { TypeKind::String, { "append", StrAppend, TypeKind::None, { TypeKind::String }, } },
+  { TypeKind::String, { "append", StrAppend, TypeKind::None, { TypeKind::Char }, } },
+  { _Vector, { "length", Length, TypeKind::Int, { }, } },
+  { _Vector, { "slice",  Slice,  _Vector,       { TypeKind::Int }, } },
+  { _Vector, { "slice",  Slice,  _Vector,       { TypeKind::Int, TypeKind::Int }, } },
+
+  { _Vector, { "push",      Push,      TypeKind::None,  { _T }, } },
+  { _Vector, { "pop",       Pop,       _T,              { }, } },
+  { _Vector, { "insert",    Insert,    TypeKind::None,  { TypeKind::Int, _T }, } },
+  { _Vector, { "extend",    Extend,    TypeKind::None,  { _Vector }, } },
+  { _Vector, { "reserve",   Reserve,   TypeKind::None,  { TypeKind::Int }, } },
+  { _Vector, { "clear",     Clear,     TypeKind::None,  { }, } },
+  { _Vector, { "capacity",  Capacity,  TypeKind::Int,   { }, } },
+  { _Vector, { "to_set",    VectorToSet, _Set,          { }, } },
+  { _Vector, { "shuffle",   VectorShuffle, TypeKind::None, { }, } },
+  { _Vector, { "sample",    VectorSample,  _Vector,        { TypeKind::Int }, } },
+
+  { _IntVector,   { "sort",        VectorSort,       TypeKind::None, { }, } },
+  { _IntVector,   { "sort_desc",   VectorSortDesc,   TypeKind::None, { }, } },
+  { _IntVector,   { "stable_sort", VectorStableSort, TypeKind::None, { }, } },
+
+  { _FloatVector, { "sort",        VectorSort,       TypeKind::None, { }, } },
+  { _FloatVector, { "sort_desc",   VectorSortDesc,   TypeKind::None, { }, } },
+  { _FloatVector, { "stable_sort", VectorStableSort, TypeKind::None, { }, } },
+
+  { _CharVector,  { "sort",        VectorSort,       TypeKind::None, { }, } },
+  { _CharVector,  { "sort_desc",   VectorSortDesc,   TypeKind::None, { }, } },
+  { _CharVector,  { "stable_sort", VectorStableSort, TypeKind::None, { }, } },
+
+  { _StrVector,   { "sort",        VectorSort,       TypeKind::None, { }, } },
+  { _StrVector,   { "sort_desc",   VectorSortDesc,   TypeKind::None, { }, } },
+  { _StrVector,   { "stable_sort", VectorStableSort, TypeKind::None, { }, } },
+
+  { _IntVector, { "sum",    VecSum<i64>,    TypeKind::Int,   { }, } },
+  { _IntVector, { "min",    VecMin<i64>,    TypeKind::Int,   { }, } },
+  { _IntVector, { "max",    VecMax<i64>,    TypeKind::Int,   { }, } },
+  { _IntVector, { "mean",   VecMean<i64>,   TypeKind::Float, { }, } },
+  { _IntVector, { "argmax", VecArgMax<i64>, TypeKind::Int,   { }, } },
+  { _IntVector, { "dot",    VecDot<i64>,    TypeKind::Int,   { _IntVector }, } },
+  { _IntVector, { "add",    VecElementwise<i64, kernels::Add<i64>>, _IntVector, { _IntVector }, } },
+  { _IntVector, { "sub",    VecElementwise<i64, kernels::Sub<i64>>, _IntVector, { _IntVector }, } },
+  { _IntVector, { "mul",    VecElementwise<i64, kernels::Mul<i64>>, _IntVector, { _IntVector }, } },
+  { _IntVector, { "scale",  VecScale<i64>,  _IntVector,      { TypeKind::Int }, } },
+  { _IntVector, { "clamp",  VecClamp<i64>,  _IntVector,      { TypeKind::Int, TypeKind::Int }, } },
+  { _IntVector, { "cumsum", VecCumSum<i64>, _IntVector,      { }, } },
+
+  { _FloatVector, { "sum",    VecSum<double>,    TypeKind::Float, { }, } },
+  { _FloatVector, { "min",    VecMin<double>,    TypeKind::Float, { }, } },
+  { _FloatVector, { "max",    VecMax<double>,    TypeKind::Float, { }, } },
+  { _FloatVector, { "mean",   VecMean<double>,   TypeKind::Float, { }, } },
+  { _FloatVector, { "argmax", VecArgMax<double>, TypeKind::Int,   { }, } },
+  { _FloatVector, { "dot",    VecDot<double>,    TypeKind::Float, { _FloatVector }, } },
+  { _FloatVector, { "add",    VecElementwise<double, kernels::Add<double>>, _FloatVector, { _FloatVector }, } },
+  { _FloatVector, { "sub",    VecElementwise<double, kernels::Sub<double>>, _FloatVector, { _FloatVector }, } },
+  { _FloatVector, { "mul",    VecElementwise<double, kernels::Mul<double>>, _FloatVector, { _FloatVector }, } },
+  { _FloatVector, { "scale",  VecScale<double>,  _FloatVector,    { TypeKind::Float }, } },
+  { _FloatVector, { "clamp",  VecClamp<double>,  _FloatVector,    { TypeKind::Float, TypeKind::Float }, } },
+  { _FloatVector, { "cumsum", VecCumSum<double>, _FloatVector,    { }, } },
+
+  { _Dict, { "length",   Length,       TypeKind::Int,  { }, } },
+  { _Dict, { "contains", DictContains, TypeKind::Bool, { _K }, } },
+  { _Dict, { "get",      DictGet,      _V,             { _K, _V }, } },
+  { _Dict, { "remove",   DictRemove,   TypeKind::Bool, { _K }, } },
+  { _Dict, { "reserve",  DictReserve,  TypeKind::None, { TypeKind::Int }, } },
+  { _Dict, { "clear",    DictClear,    TypeKind::None, { }, } },
+  { _Dict, { "keys",     DictKeys,     _KVector,       { }, } },
+  { _Dict, { "values",   DictValues,   _VVector,       { }, } },
+
+  { _Set, { "length",   Length,       TypeKind::Int,  { }, } },
+  { _Set, { "add",      SetAdd,       TypeKind::Bool, { _T }, } },
+  { _Set, { "contains", DictContains, TypeKind::Bool, { _T }, } },
+  { _Set, { "remove",   DictRemove,   TypeKind::Bool, { _T }, } },
+  { _Set, { "reserve",  DictReserve,  TypeKind::None, { TypeKind::Int }, } },
+  { _Set, { "clear",    DictClear,    TypeKind::None, { }, } },
+  { _Set, { "values",   DictKeys,     _Vector,        { }, } },
+
+  { TypeKind::BitSet, { "set",        BitSetSet,        TypeKind::None,   { TypeKind::Int }, } },
+  { TypeKind::BitSet, { "reset",      BitSetReset,      TypeKind::None,   { TypeKind::Int }, } },
+  { TypeKind::BitSet, { "flip",       BitSetFlip,       TypeKind::None,   { TypeKind::Int }, } },
+  { TypeKind::BitSet, { "test",       BitSetTest,       TypeKind::Bool,   { TypeKind::Int }, } },
+  { TypeKind::BitSet, { "count",      BitSetCount,      TypeKind::Int,    { }, } },
+  { TypeKind::BitSet, { "size",       BitSetSize,       TypeKind::Int,    { }, } },
+  { TypeKind::BitSet, { "clear",      BitSetClear,      TypeKind::None,   { }, } },
+  { TypeKind::BitSet, { "union",      BitSetUnion,      TypeKind::BitSet, { TypeKind::BitSet }, } },
+  { TypeKind::BitSet, { "intersect",  BitSetIntersect,  TypeKind::BitSet, { TypeKind::BitSet }, } },
+  { TypeKind::BitSet, { "difference", BitSetDifference, TypeKind::BitSet, { TypeKind::BitSet }, } },
+  { TypeKind::BitSet, { "ones",       BitSetOnes,       _IntVector,       { }, } },
+  { TypeKind::BitSet, { "next",       BitSetNext,       TypeKind::Int,    { TypeKind::Int }, } },
+
+  { _Deque, { "length",     Length,         TypeKind::Int,  { }, } },
+  { _Deque, { "push_back",  DequePushBack,  TypeKind::None, { _T }, } },
+  { _Deque, { "push_front", DequePushFront, TypeKind::None, { _T }, } },
+  { _Deque, { "pop_back",   DequePopBack,   _T,             { }, } },
+  { _Deque, { "pop_front",  DequePopFront,  _T,             { }, } },
+  { _Deque, { "front",      DequeFront,     _T,             { }, } },
+  { _Deque, { "back",       DequeBack,      _T,             { }, } },
+  { _Deque, { "clear",      DequeClear,     TypeKind::None, { }, } },
+
+  { _PQueue, { "length",       Length,            TypeKind::Int,  { }, } },
+  { _PQueue, { "push",         PQueuePush,        TypeKind::None, { _T }, } },
+  { _PQueue, { "pop",          PQueuePop,         _T,             { }, } },
+  { _PQueue, { "top",          PQueueTop,         _T,             { }, } },
+  { _PQueue, { "clear",        PQueueClear,       TypeKind::None, { }, } },
+  { _PQueue, { "set_reversed", PQueueSetReversed, TypeKind::None, { TypeKind::Bool }, } },
+  { _PQueue, { "sorted",       PQueueSorted,      _Vector,        { }, } },
+
+  { TypeKind::Matrix, { "rows",      MatrixRows,      TypeKind::Int,    { }, } },
+  { TypeKind::Matrix, { "cols",      MatrixCols,      TypeKind::Int,    { }, } },
+  { TypeKind::Matrix, { "transpose", MatrixTranspose, TypeKind::Matrix, { }, } },
+  { TypeKind::Matrix, { "matmul",    MatrixMatMul,    TypeKind::Matrix, { TypeKind::Matrix }, } },
+  { TypeKind::Matrix, { "matvec",    MatrixMatVec,    _FloatVector,     { _FloatVector }, } },
+  { TypeKind::Matrix, { "row_sums",  MatrixRowSums,   _FloatVector,     { }, } },
+  { TypeKind::Matrix, { "col_sums",  MatrixColSums,   _FloatVector,     { }, } },
+  { TypeKind::Matrix, { "sum",       MatrixSum,       TypeKind::Float,  { }, } },
+  { TypeKind::Matrix, { "row",       MatrixRow,       _FloatVector,     { TypeKind::Int }, } },
+  { TypeKind::Matrix, { "fill",      MatrixFill,      TypeKind::None,   { TypeKind::Float }, } },
+
+  { _OrderedMap, { "length",       OMapLength,     TypeKind::Int,  { }, } },
+  { _OrderedMap, { "contains",     OMapContains,   TypeKind::Bool, { _K }, } },
+  { _OrderedMap, { "get",          OMapGet,        _V,             { _K, _V }, } },
+  { _OrderedMap, { "remove",       OMapRemove,     TypeKind::Bool, { _K }, } },
+  { _OrderedMap, { "clear",        OMapClear,      TypeKind::None, { }, } },
+  { _OrderedMap, { "first",        OMapFirst,      _K,             { }, } },
+  { _OrderedMap, { "last",         OMapLast,       _K,             { }, } },
+  { _OrderedMap, { "lower_bound",  OMapLowerBound, _KVector,       { _K }, } },
+  { _OrderedMap, { "upper_bound",  OMapUpperBound, _KVector,       { _K }, } },
+  { _OrderedMap, { "keys",         OMapKeys,       _KVector,       { }, } },
+  { _OrderedMap, { "values",       OMapValues,     _VVector,       { }, } },
+  { _OrderedMap, { "range",        OMapKeys,       _KVector,       { _K, _K }, } },
+  { _OrderedMap, { "range_values", OMapValues,     _VVector,       { _K, _K }, } },
+
+  { TypeKind::StringBuilder, { "append",  SBAppend,  TypeKind::None,   { TypeKind::String }, } },
+  { TypeKind::StringBuilder, { "append",  SBAppend,  TypeKind::None,   { TypeKind::Char }, } },
+  { TypeKind::StringBuilder, { "append",  SBAppend,  TypeKind::None,   { TypeKind::Int }, } },
+  { TypeKind::StringBuilder, { "append",  SBAppend,  TypeKind::None,   { TypeKind::Float }, } },
+  { TypeKind::StringBuilder, { "reserve", SBReserve, TypeKind::None,   { TypeKind::Int }, } },
+  { TypeKind::StringBuilder, { "length",  SBLength,  TypeKind::Int,    { }, } },
+  { TypeKind::StringBuilder, { "clear",   SBClear,   TypeKind::None,   { }, } },
+  { TypeKind::StringBuilder, { "build",   SBBuild,   TypeKind::String, { }, } },
+
+  { TypeKind::Regex, { "match",    RegexMatch,   TypeKind::Bool,   { TypeKind::String }, } },
+  { TypeKind::Regex, { "search",   RegexSearch,  _IntVector,       { TypeKind::String }, } },
+  { TypeKind::Regex, { "search",   RegexSearch,  _IntVector,       { TypeKind::String, TypeKind::Int }, } },
+  { TypeKind::Regex, { "find_all", RegexFindAll, _StrVector,       { TypeKind::String }, } },
+  { TypeKind::Regex, { "replace",  RegexReplace, TypeKind::String, { TypeKind::String, TypeKind::String }, } },
+
+  { TypeKind::LineReader, { "has_next", LineReaderHasNext, TypeKind::Bool,   { }, } },
+  { TypeKind::LineReader, { "next",     LineReaderNext,    TypeKind::String, { }, } },
+  
+  { TypeKind::Bytes, { "length",       Length,                    TypeKind::Int,     { }, } },
+  { TypeKind::Bytes, { "slice",        Slice,                     TypeKind::Bytes,   { TypeKind::Int }, } },
+  { TypeKind::Bytes, { "slice",        Slice,                     TypeKind::Bytes,   { TypeKind::Int, TypeKind::Int }, } },
+  { TypeKind::Bytes, { "append",       BytesAppend,               TypeKind::None,    { TypeKind::Bytes }, } },
+  { TypeKind::Bytes, { "decode",       BytesDecode,               TypeKind::String,  { }, } },
+  { TypeKind::Bytes, { "hex",          BytesHex,                  TypeKind::String,  { }, } },
+  { TypeKind::Bytes, { "to_vector",    BytesToVector,             _U8Vector,         { }, } },
+  { TypeKind::Bytes, { "read_u8",      BytesRead<u8>,             TypeKind::Int,     { TypeKind::Int }, } },
+  { TypeKind::Bytes, { "read_i8",      BytesRead<i8>,             TypeKind::Int,     { TypeKind::Int }, } },
+  { TypeKind::Bytes, { "read_u16_le",  BytesRead<u16>,            TypeKind::Int,     { TypeKind::Int }, } },
+  { TypeKind::Bytes, { "read_u16_be",  BytesRead<u16, true>,      TypeKind::Int,     { TypeKind::Int }, } },
+  { TypeKind::Bytes, { "read_i16_le",  BytesRead<i16>,            TypeKind::Int,     { TypeKind::Int }, } },
+  { TypeKind::Bytes, { "read_i16_be",  BytesRead<i16, true>,      TypeKind::Int,     { TypeKind::Int }, } },
+  { TypeKind::Bytes, { "read_u32_le",  BytesRead<u32>,            TypeKind::Int,     { TypeKind::Int }, } },
+  { TypeKind::Bytes, { "read_u32_be",  BytesRead<u32, true>,      TypeKind::Int,     { TypeKind::Int }, } },
+  { TypeKind::Bytes, { "read_i32_le",  BytesRead<i32>,            TypeKind::Int,     { TypeKind::Int }, } },
+  { TypeKind::Bytes, { "read_i32_be",  BytesRead<i32, true>,      TypeKind::Int,     { TypeKind::Int }, } },
+  { TypeKind::Bytes, { "read_u64_le",  BytesRead<u64>,            TypeKind::U64,     { TypeKind::Int }, } },
+  { TypeKind::Bytes, { "read_u64_be",  BytesRead<u64, true>,      TypeKind::U64,     { TypeKind::Int }, } },
+  { TypeKind::Bytes, { "read_i64_le",  BytesRead<i64>,            TypeKind::Int,     { TypeKind::Int }, } },
+  { TypeKind::Bytes, { "read_i64_be",  BytesRead<i64, true>,      TypeKind::Int,     { TypeKind::Int }, } },
+  { TypeKind::Bytes, { "read_f32_le",  BytesRead<float>,          TypeKind::Float,   { TypeKind::Int }, } },
+  { TypeKind::Bytes, { "read_f32_be",  BytesRead<float, true>,    TypeKind::Float,   { TypeKind::Int }, } },
+  { TypeKind::Bytes, { "read_f64_le",  BytesRead<double>,         TypeKind::Float,   { TypeKind::Int }, } },
+  { TypeKind::Bytes, { "read_f64_be",  BytesRead<double, true>,   TypeKind::Float,   { TypeKind::Int }, } },
+  { TypeKind::Bytes, { "write_u8",     BytesWrite<u8>,            TypeKind::None,    { TypeKind::Int, TypeKind::Int }, } },
+  { TypeKind::Bytes, { "write_u16_le", BytesWrite<u16>,           TypeKind::None,    { TypeKind::Int, TypeKind::Int }, } },
+  { TypeKind::Bytes, { "write_u16_be", BytesWrite<u16, true>,     TypeKind::None,    { TypeKind::Int, TypeKind::Int }, } },
+  { TypeKind::Bytes, { "write_u32_le", BytesWrite<u32>,           TypeKind::None,    { TypeKind::Int, TypeKind::Int }, } },
+  { TypeKind::Bytes, { "write_u32_be", BytesWrite<u32, true>,     TypeKind::None,    { TypeKind::Int, TypeKind::Int }, } },
+  { TypeKind::Bytes, { "write_u64_le", BytesWrite<u64>,           TypeKind::None,    { TypeKind::Int, TypeKind::Int }, } },
+  { TypeKind::Bytes, { "write_u64_be", BytesWrite<u64, true>,     TypeKind::None,    { TypeKind::Int, TypeKind::Int }, } },
+  { TypeKind::Bytes, { "write_u64_le", BytesWrite<u64>,           TypeKind::None,    { TypeKind::Int, TypeKind::U64 }, } },
+  { TypeKind::Bytes, { "write_u64_be", BytesWrite<u64, true>,     TypeKind::None,    { TypeKind::Int, TypeKind::U64 }, } },
+  { TypeKind::Bytes, { "write_f32_le", BytesWrite<float>,         TypeKind::None,    { TypeKind::Int, TypeKind::Float }, } },
+  { TypeKind::Bytes, { "write_f32_be", BytesWrite<float, true>,   TypeKind::None,    { TypeKind::Int, TypeKind::Float }, } },
+  { TypeKind::Bytes, { "write_f64_le", BytesWrite<double>,        TypeKind::None,    { TypeKind::Int, TypeKind::Float }, } },
+  { TypeKind::Bytes, { "write_f64_be", BytesWrite<double, true>,  TypeKind::None,    { TypeKind::Int, TypeKind::Float }, } },
+
+  { TypeKind::I8,  { "to_int", FixedIntToInt, TypeKind::Int, { }, } },
+  { TypeKind::I16, { "to_int", FixedIntToInt, TypeKind::Int, { }, } },
+  { TypeKind::I32, { "to_int", FixedIntToInt, TypeKind::Int, { }, } },
+  { TypeKind::U8,  { "to_int", FixedIntToInt, TypeKind::Int, { }, } },
+  { TypeKind::U16, { "to_int", FixedIntToInt, TypeKind::Int, { }, } },
+  { TypeKind::U32, { "to_int", FixedIntToInt, TypeKind::Int, { }, } },
+  { TypeKind::U64, { "to_int", FixedIntToInt, TypeKind::Int, { }, } },
 
-  { TypeKind::String, { "length", Length, TypeKind::Int, { }, } },
-  { TypeKind::Vector, { "length", Length, TypeKind::Int, { }, } },
-  
   { TypeKind::Unknown, { "to_string", ToString, TypeKind::String, { }, } },
   
   // { "length",   Length,    TypeKind::Int, { {TypeKind::Vector, {TypeKind::Unknown}} }, },
@@ -5,6 +5,7 @@
 #include "AST.h"
 #include "Utils.h"
 #include "Error.h"
+#include "IO.h"
 
 #include "Lexer.h"
 #include "Parser.h"
@@ -21,6 +22,10 @@ usage: flame [options] scripts...
 options:
     -h --help         show this information
     -v --version      show version info
+
+    --stdout-buffer=SIZE
+                      size of stdout buffer (bytes, or with suffix K / M)
+                      0 = not buffered. default is 64K.
 )";
 
 static constexpr auto command_version = R"(
@@ -35,11 +40,47 @@ struct CmdLineArguments {
   // -v, --version
   bool version_info = false;
 
+  // --stdout-buffer=SIZE
+  //   -1 = default
+  i64 stdout_buffer_size = -1;
+
   //
   // [source files]
   StringVector sources;
 };
 
+//
+// "4096", "64K", "1M"
+//   returns -1 if invalid.
+static i64 parse_size(std::string_view str) {
+  i64 n = 0;
+  size_t i = 0;
+
+  for (; i < str.length() && '0' <= str[i] && str[i] <= '9'; i++) {
+    n = n * 10 + (str[i] - '0');
+
+    if (n > (1LL << 32))
+      return -1;
+  }
+
+  if (i == 0)
+    return -1;
+
+  if (i + 1 == str.length()) {
+    switch (str[i]) {
+    case 'k':
+    case 'K':
+      return n << 10;
+
+    case 'm':
+    case 'M':
+      return n << 20;
+    }
+  }
+
+  return i == str.length() ? n : -1;
+}
+
 int parse_command_line(CmdLineArguments& cmd, int argc, char** argv) {
 
   while (argc--) {
@@ -51,6 +92,13 @@ int parse_command_line(CmdLineArguments& cmd, int argc, char** argv) {
     else if (arg == "-v" || arg == "--version")
       cmd.version_info = true;
 
+    else if (arg.starts_with("--stdout-buffer=")) {
+      cmd.stdout_buffer_size = parse_size(std::string_view(arg).substr(16));
+
+      if (cmd.stdout_buffer_size < 0)
+        Error::fatal_error("invalid buffer size: '" + arg + "'");
+    }
+
     else
       cmd.sources.emplace_back(std::move(arg));
   }
@@ -83,6 +131,9 @@ int FireDriver::fire_main(int argc, char** argv) {
     fire::Error::fatal_error("no input files.");
   }
 
+  if (args.stdout_buffer_size >= 0)
+    io::out().SetBufferSize((size_t)args.stdout_buffer_size);
+
   for (auto&& path : args.sources) {
     sources.emplace_back(path);
   }
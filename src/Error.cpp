@@ -5,6 +5,7 @@
 #include "Color.h"
 
 #include "Error.h"
+#include "IO.h"
 
 #define COL_WARNING COL_MAGENTA
 #define COL_ERROR COL_RED
@@ -105,6 +106,9 @@ Error const& Error::emit() const {
   using std::cout;
   using std::endl;
 
+  // output of script must be written before error.
+  io::out().Flush();
+
   Token const& err_token = this->loc_ast ? this->loc_ast->token : this->loc_token;
 
   line_data_wrapper_t line_top, line_bottom, line_err = line_data_wrapper_t(err_token);
@@ -195,6 +199,8 @@ void Error::stop() {
 }
 
 void Error::fatal_error(std::string const& msg) {
+  io::out().Flush();
+
   std::cout << COL_BOLD COL_RED << "fatal error: " << COL_DEFAULT << msg << std::endl;
 
   std::exit(2);
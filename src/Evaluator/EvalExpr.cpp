@@ -19,6 +19,13 @@ static inline ObjPtr<ObjPrimitive> new_bool(bool b) {
 static inline ObjPtr<ObjIterable> multiply_array(ObjPtr<ObjIterable> s, i64 n) {
   ObjPtr<ObjIterable> ret = PtrCast<ObjIterable>(s->Clone());
 
+  if (n <= 0) {
+    ret->Clear();
+    return ret;
+  }
+
+  ret->Reserve(s->Count() * n);
+
   while (--n) {
     ret->AppendList(s);
   }
@@ -26,6 +33,41 @@ static inline ObjPtr<ObjIterable> multiply_array(ObjPtr<ObjIterable> s, i64 n) {
   return ret;
 }
 
+//
+// str + str, str + char, char + str
+//
+static inline ObjPtr<ObjString> concat_string(ObjPointer lhs, ObjPointer rhs) {
+  auto view = [](ObjPointer const& obj) -> std::u16string_view {
+    if (obj->is_char())
+      return {&obj->As<ObjPrimitive>()->vc, 1};
+
+    return obj->As<ObjString>()->View();
+  };
+
+  auto a = view(lhs);
+  auto b = view(rhs);
+
+  std::u16string s;
+
+  s.reserve(a.length() + b.length());
+  s.append(a).append(b);
+
+  return ObjNew<ObjString>(std::move(s));
+}
+
+static inline ObjPtr<ObjString> repeat_string(ObjPtr<ObjString> s, i64 n) {
+  std::u16string ret;
+
+  if (n > 0) {
+    ret.reserve(s->Length() * n);
+
+    while (n--)
+      ret.append(s->View());
+  }
+
+  return ObjNew<ObjString>(std::move(ret));
+}
+
 static inline ObjPtr<ObjIterable> add_vec_wrap(ObjPtr<ObjIterable> v, ObjPointer e) {
   v = PtrCast<ObjIterable>(v->Clone());
 
@@ -34,12 +76,86 @@ static inline ObjPtr<ObjIterable> add_vec_wrap(ObjPtr<ObjIterable> v, ObjPointer
   return v;
 }
 
+//
+// i8 .. u64
+//   計算は 64 bit で行い、結果を型の幅に丸める (wrap around)
+//   u64 の除算・剰余・右シフト・比較は符号なし
+//
+static ObjPointer eval_fixed_int(ASTPtr<AST::Expr> ast, ObjPointer const& lhs,
+                                 ObjPointer const& rhs) {
+  using Kind = ASTKind;
+
+  auto kind = lhs->type.kind;
+  bool is_u64 = kind == TypeKind::U64;
+
+  i64 a = lhs->as_primitive()->vi;
+  i64 b = rhs->as_primitive()->vi;
+
+  auto ret = [kind](i64 v) { return ObjNew<ObjPrimitive>(kind, v); };
+
+  switch (ast->kind) {
+  case Kind::Add:
+    return ret((i64)((u64)a + (u64)b));
+
+  case Kind::Sub:
+    return ret((i64)((u64)a - (u64)b));
+
+  case Kind::Mul:
+    return ret((i64)((u64)a * (u64)b));
+
+  case Kind::Div:
+  case Kind::Mod:
+    if (b == 0)
+      throw Error(ast->op, "divided by zero");
+
+    if (is_u64)
+      return ret((i64)(ast->kind == Kind::Div ? (u64)a / (u64)b : (u64)a % (u64)b));
+
+    return ret(ast->kind == Kind::Div ? a / b : a % b);
+
+  case Kind::BitAND:
+    return ret(a & b);
+
+  case Kind::BitXOR:
+    return ret(a ^ b);
+
+  case Kind::BitOR:
+    return ret(a | b);
+
+  case Kind::LShift:
+    return ret((u64)b >= 64 ? 0 : (i64)((u64)a << b));
+
+  case Kind::RShift:
+    if (is_u64)
+      return ret((u64)b >= 64 ? 0 : (i64)((u64)a >> b));
+
+    return ret(a >> std::min<u64>(b, 63));
+
+  case Kind::Bigger:
+    return new_bool(is_u64 ? (u64)a > (u64)b : a > b);
+
+  case Kind::BiggerOrEqual:
+    return new_bool(is_u64 ? (u64)a >= (u64)b : a >= b);
+
+  case Kind::Equal:
+    return new_bool(a == b);
+  }
+
+  not_implemented("not implemented operator: " << lhs->type.to_string() << " " << ast->op.str
+                                               << " " << rhs->type.to_string());
+
+  return lhs;
+}
+
 ObjPointer Evaluator::eval_expr(ASTPtr<AST::Expr> ast) {
   using Kind = ASTKind;
 
   ObjPointer lhs = this->evaluate(ast->lhs);
   ObjPointer rhs = this->evaluate(ast->rhs);
 
+  if (lhs->is_fixed_int())
+    return eval_fixed_int(ast, lhs, rhs);
+
   switch (ast->kind) {
 
   case Kind::Add: {
@@ -57,10 +173,9 @@ ObjPointer Evaluator::eval_expr(ASTPtr<AST::Expr> ast) {
     case TypeKind::Float:
       return new_float(lhs->get_vf() + rhs->get_vf());
 
+    case TypeKind::Char:
     case TypeKind::String:
-      lhs = lhs->Clone();
-      lhs->As<ObjString>()->AppendList(PtrCast<ObjIterable>(rhs));
-      return lhs;
+      return concat_string(lhs, rhs);
 
     default:
       todo_impl;
@@ -82,10 +197,16 @@ ObjPointer Evaluator::eval_expr(ASTPtr<AST::Expr> ast) {
   }
 
   case Kind::Mul: {
-    if ((lhs->is_string() || lhs->is_vector()) && rhs->is_int())
+    if (lhs->is_string() && rhs->is_int())
+      return repeat_string(PtrCast<ObjString>(lhs), rhs->get_vi());
+
+    if (rhs->is_string() && lhs->is_int())
+      return repeat_string(PtrCast<ObjString>(rhs), lhs->get_vi());
+
+    if (lhs->is_vector() && rhs->is_int())
       return multiply_array(PtrCast<ObjIterable>(lhs), rhs->get_vi());
 
-    if ((rhs->is_string() || rhs->is_vector()) && lhs->is_int())
+    if (rhs->is_vector() && lhs->is_int())
       return multiply_array(PtrCast<ObjIterable>(rhs), lhs->get_vi());
 
     switch (lhs->type.kind) {
@@ -1,4 +1,5 @@
 #include "Builtin.h"
+#include "Sema/Sema.h"
 #include "Evaluator.h"
 #include "Error.h"
 
@@ -141,7 +142,7 @@ void Evaluator::eval_stmt(ASTPointer ast) {
           stack->var_list[0] = obj_to_cmp->data;
         }
         else {
-          auto& list = obj_to_cmp->data->As<ObjIterable>()->list;
+          auto const& list = obj_to_cmp->data->As<ObjIterable>()->GetList();
 
           for (size_t i = 0, j = 0; i < cf->args.size(); i++) {
             if (iter != P.vardef_list.end() && iter->first == i) {
@@ -230,8 +231,17 @@ void Evaluator::eval_stmt(ASTPointer ast) {
   case Kind::Vardef: {
     CAST(VarDef);
 
+    auto& var = this->get_cur_stack().var_list[x->index + x->index_add];
+
     if (x->init) {
-      this->get_cur_stack().var_list[x->index + x->index_add] = this->evaluate(x->init);
+      var = this->evaluate(x->init);
+
+      // 文字列とバイト列は値として扱う (バッファは共有され、変更時にコピーされる)
+      if (var->is_string() || var->is_bytes())
+        var = var->Clone();
+    }
+    else {
+      var = this->MakeDefaultValueOfType(this->S.eval_type(x->type));
     }
 
     break;
@@ -1,4 +1,5 @@
 #include "Builtin.h"
+#include "BTree.h"
 #include "Sema/Sema.h"
 #include "Evaluator.h"
 #include "Error.h"
@@ -60,17 +61,56 @@ ObjPointer Evaluator::MakeDefaultValueOfType(TypeInfo const& type) {
   case TypeKind::Char:
     return ObjNew<ObjPrimitive>((char16_t)0);
 
+  case TypeKind::I8:
+  case TypeKind::I16:
+  case TypeKind::I32:
+  case TypeKind::U8:
+  case TypeKind::U16:
+  case TypeKind::U32:
+  case TypeKind::U64:
+    return ObjNew<ObjPrimitive>(type.kind, 0);
+
   case TypeKind::String:
     return ObjNew<ObjString>();
 
+  case TypeKind::StringBuilder:
+    return ObjNew<ObjStringBuilder>();
+
   case TypeKind::Vector:
-    return ObjNew<ObjIterable>(TypeKind::Vector);
+    return ObjNew<ObjIterable>(type);
 
-  case TypeKind::Tuple:
-    todo_impl;
+  case TypeKind::Tuple: {
+    auto obj = ObjNew<ObjTuple>(type);
+
+    for (size_t i = 0; i < type.params.size(); i++)
+      obj->At(i) = this->MakeDefaultValueOfType(type.params[i]);
+
+    return obj;
+  }
 
   case TypeKind::Dict:
-    todo_impl;
+    return ObjNew<ObjDict>(type);
+
+  case TypeKind::OrderedMap:
+    return ObjNew<ObjOrderedMap>(type);
+
+  case TypeKind::Set:
+    return ObjNew<ObjSet>(type);
+
+  case TypeKind::BitSet:
+    return ObjNew<ObjBitSet>(0);
+
+  case TypeKind::Deque:
+    return ObjNew<ObjDeque>(type);
+
+  case TypeKind::PriorityQueue:
+    return ObjNew<ObjPriorityQueue>(type);
+
+  case TypeKind::Matrix:
+    return ObjNew<ObjMatrix>(0, 0);
+
+  case TypeKind::Bytes:
+    return ObjNew<ObjBytes>();
 
   case TypeKind::TypeName: {
     todo_impl;
@@ -107,13 +147,60 @@ VarStack& Evaluator::get_stack(int distance) {
   return **it;
 }
 
+// ring buffer of deque wraps around; index must be checked.
+static size_t check_deque_index(ObjPointer const& deque, ObjPointer const& index,
+                                ASTPointer ast) {
+  auto i = index->get_vi();
+
+  if (i < 0 || (size_t)i >= deque->As<ObjDeque>()->Count())
+    throw Error(ast, "index out of range");
+
+  return (size_t)i;
+}
+
+static size_t check_bytes_index(ObjPointer const& bytes, ObjPointer const& index,
+                                ASTPointer ast) {
+  auto i = index->get_vi();
+
+  if (i < 0 || (size_t)i >= bytes->As<ObjBytes>()->Length())
+    throw Error(ast, "index out of range");
+
+  return (size_t)i;
+}
+
+//
+// element of matrix:  m[i, j]
+//   index is a tuple literal; elements are evaluated without making tuple.
+//
+double& Evaluator::eval_matrix_element(ObjPointer const& matrix, ASTPointer index) {
+  auto m = matrix->As<ObjMatrix>();
+  auto& ij = index->As<AST::Array>()->elements;
+
+  auto i = this->evaluate(ij[0])->get_vi();
+  auto j = this->evaluate(ij[1])->get_vi();
+
+  if (i < 0 || (size_t)i >= m->rows)
+    throw Error(ij[0], "row index out of range");
+
+  if (j < 0 || (size_t)j >= m->cols)
+    throw Error(ij[1], "column index out of range");
+
+  return m->At((size_t)i, (size_t)j);
+}
+
 ObjPointer& Evaluator::eval_as_left(ASTPointer ast) {
 
   switch (ast->kind) {
   case ASTKind::IndexRef: {
     auto ex = ast->as_expr();
 
-    return this->eval_index_ref(this->eval_as_left(ex->lhs), this->evaluate(ex->rhs));
+    auto& array = this->eval_as_left(ex->lhs);
+    auto index = this->evaluate(ex->rhs);
+
+    if (array->is_deque())
+      check_deque_index(array, index, ex->rhs);
+
+    return this->eval_index_ref(array, index);
   }
 
   case ASTKind::RefMemberVar_Left: {
@@ -134,19 +221,30 @@ ObjPointer& Evaluator::eval_as_left(ASTPointer ast) {
 }
 
 ObjPointer& Evaluator::eval_index_ref(ObjPointer array, ObjPointer _index_obj) {
+  // key is inserted if not exists. (assignment)
+  if (array->is_dict())
+    return array->As<ObjDict>()->GetOrInsert(_index_obj);
+
+  if (array->is_ordered_map())
+    return array->As<ObjOrderedMap>()->GetMutable().GetOrInsert(_index_obj);
+
   assert(_index_obj->type.kind == TypeKind::Int);
 
-  i64 index = _index_obj->As<ObjPrimitive>()->vi;
+  if (array->is_deque())
+    return array->As<ObjDeque>()->GetMutable().At((size_t)_index_obj->get_vi());
 
-  switch (array->type.kind) {
-  case TypeKind::Dict: {
-    todo_impl;
-  }
-  }
+  if (array->is_tuple())
+    return array->As<ObjTuple>()->At((size_t)_index_obj->get_vi());
+
+  i64 index = _index_obj->As<ObjPrimitive>()->vi;
 
   debug(assert(array->type.kind == TypeKind::Vector));
 
-  return array->As<ObjIterable>()->list[(size_t)index];
+  // unboxed element has no object to refer; assignment is done in Kind::Assign.
+  assert(!array->As<ObjIterable>()->IsUnboxed());
+
+  // the element may be modified; make list unique. (copy-on-write)
+  return array->As<ObjIterable>()->GetMutableList()[(size_t)index];
 }
 
 ObjPointer& Evaluator::eval_member_ref(ObjPtr<ObjInstance> inst,
@@ -182,7 +280,14 @@ ObjPointer Evaluator::evaluate(ASTPointer ast) {
     panic;
 
   case Kind::Value: {
-    return ast->as_value()->value;
+    auto& value = ast->as_value()->value;
+
+    // literal of string is mutable object; don't share itself.
+    // (cheap, because the content is copy-on-write.)
+    if (value->is_string())
+      return value->Clone();
+
+    return value;
   }
 
   case Kind::Variable:
@@ -208,10 +313,72 @@ ObjPointer Evaluator::evaluate(ASTPointer ast) {
     return obj;
   }
 
+  case Kind::Tuple: {
+    CAST(Array);
+
+    auto obj = ObjNew<ObjTuple>(x->elem_type);
+
+    for (size_t i = 0; i < x->elements.size(); i++)
+      obj->At(i) = this->evaluate(x->elements[i]);
+
+    return obj;
+  }
+
+  case Kind::Dict: {
+    CAST(Dict);
+
+    auto obj = ObjNew<ObjDict>(x->type);
+
+    obj->Reserve(x->keys.size());
+
+    for (size_t i = 0; i < x->keys.size(); i++)
+      obj->Insert(this->evaluate(x->keys[i]), this->evaluate(x->values[i]));
+
+    return obj;
+  }
+
   case Kind::IndexRef: {
     auto ex = ast->as_expr();
 
-    return this->eval_index_ref(this->evaluate(ex->lhs), this->evaluate(ex->rhs));
+    auto array = this->evaluate(ex->lhs);
+
+    if (array->is_matrix())
+      return ObjNew<ObjPrimitive>(this->eval_matrix_element(array, ex->rhs));
+
+    auto index = this->evaluate(ex->rhs);
+
+    // read only; don't detach shared list.
+    if (array->is_vector())
+      return array->As<ObjIterable>()->At((size_t)index->get_vi());
+
+    if (array->is_string())
+      return ObjNew<ObjPrimitive>(array->As<ObjString>()->At((size_t)index->get_vi()));
+
+    if (array->is_deque())
+      return array->As<ObjDeque>()->At(check_deque_index(array, index, ex->rhs));
+
+    if (array->is_bytes())
+      return ObjNew<ObjPrimitive>(
+          TypeKind::U8, array->As<ObjBytes>()->View()[check_bytes_index(array, index, ex->rhs)]);
+
+    if (array->is_tuple())
+      return array->As<ObjTuple>()->At((size_t)index->get_vi());
+
+    if (array->is_dict()) {
+      if (auto value = array->As<ObjDict>()->Find(index))
+        return *value;
+
+      throw Error(ex->rhs, "key not found: " + index->ToStringAsMember());
+    }
+
+    if (array->is_ordered_map()) {
+      if (auto value = array->As<ObjOrderedMap>()->Get().Find(index))
+        return *value;
+
+      throw Error(ex->rhs, "key not found: " + index->ToStringAsMember());
+    }
+
+    return this->eval_index_ref(array, index);
   }
 
   case Kind::LambdaFunc: {
@@ -305,6 +472,9 @@ ObjPointer Evaluator::evaluate(ASTPointer ast) {
         _func = functor->func;
       else
         _builtin = functor->builtin;
+
+      if (functor->is_member_call)
+        args.insert(args.begin(), functor->selfobj);
     }
 
     if (_builtin) {
@@ -382,7 +552,42 @@ ObjPointer Evaluator::evaluate(ASTPointer ast) {
   case Kind::Assign: {
     auto x = ast->as_expr();
 
-    return this->eval_as_left(x->lhs) = this->evaluate(x->rhs);
+    auto rhs = this->evaluate(x->rhs);
+
+    if (rhs->is_string() || rhs->is_bytes())
+      rhs = rhs->Clone();
+
+    // element of unboxed vector is stored directly.
+    if (x->lhs->Is(Kind::IndexRef)) {
+      auto ex = x->lhs->as_expr();
+      auto& array = this->eval_as_left(ex->lhs);
+
+      if (array->is_matrix()) {
+        this->eval_matrix_element(array, ex->rhs) = rhs->get_vf();
+        return rhs;
+      }
+
+      auto index = this->evaluate(ex->rhs);
+
+      if (array->is_vector() && array->As<ObjIterable>()->IsUnboxed()) {
+        array->As<ObjIterable>()->Set((size_t)index->get_vi(), rhs);
+        return rhs;
+      }
+
+      if (array->is_bytes()) {
+        auto i = check_bytes_index(array, index, ex->rhs);
+
+        array->As<ObjBytes>()->GetMutable()[i] = (u8)rhs->as_primitive()->vi;
+        return rhs;
+      }
+
+      if (array->is_deque())
+        check_deque_index(array, index, ex->rhs);
+
+      return this->eval_index_ref(array, index) = rhs;
+    }
+
+    return this->eval_as_left(x->lhs) = rhs;
   }
 
   case Kind::Return:
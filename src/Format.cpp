@@ -0,0 +1,198 @@
+#include <charconv>
+
+#include "Format.h"
+#include "Object.h"
+#include "Utils.h"
+
+namespace fire::builtins {
+
+std::shared_ptr<FormatString> FormatString::Compile(std::u16string_view fmt) {
+  auto ret = std::make_shared<FormatString>();
+
+  Segment seg;
+
+  auto number = [&](size_t& i) {
+    int n = 0;
+
+    while (i < fmt.length() && u'0' <= fmt[i] && fmt[i] <= u'9') {
+      n = n * 10 + (fmt[i++] - u'0');
+
+      if (n > 4096)
+        throw FormatError{"too large number", i};
+    }
+
+    return n;
+  };
+
+  for (size_t i = 0; i < fmt.length(); i++) {
+    auto c = fmt[i];
+
+    if (c == u'}') {
+      if (i + 1 < fmt.length() && fmt[i + 1] == u'}') {
+        seg.literal += u'}';
+        i++;
+        continue;
+      }
+
+      throw FormatError{"unmatched '}'", i};
+    }
+
+    if (c != u'{') {
+      seg.literal += c;
+      continue;
+    }
+
+    if (i + 1 < fmt.length() && fmt[i + 1] == u'{') {
+      seg.literal += u'{';
+      i++;
+      continue;
+    }
+
+    size_t begin = i++;
+
+    // spec
+    if (i < fmt.length() && fmt[i] == u':') {
+      i++;
+
+      if (i < fmt.length() && (fmt[i] == u'<' || fmt[i] == u'>'))
+        seg.left_align = fmt[i++] == u'<';
+
+      seg.width = number(i);
+
+      if (i < fmt.length() && fmt[i] == u'.') {
+        i++;
+
+        if (i >= fmt.length() || fmt[i] < u'0' || u'9' < fmt[i])
+          throw FormatError{"expected precision", i};
+
+        seg.precision = number(i);
+      }
+
+      if (i < fmt.length() && fmt[i] == u'x') {
+        seg.hex = true;
+        i++;
+      }
+    }
+
+    if (i >= fmt.length() || fmt[i] != u'}')
+      throw FormatError{"invalid format specifier", begin};
+
+    seg.has_arg = true;
+
+    ret->segments.emplace_back(std::move(seg));
+    ret->arg_count++;
+
+    seg = {};
+  }
+
+  if (!seg.literal.empty())
+    ret->segments.emplace_back(std::move(seg));
+
+  return ret;
+}
+
+static void append_ascii(std::string& out, char const* s, size_t n) {
+  out.append(s, n);
+}
+
+static void append_ascii(std::u16string& out, char const* s, size_t n) {
+  out.append(s, s + n);
+}
+
+static void append_str(std::string& out, std::u16string_view s) {
+  utils::append_u8string(out, s);
+}
+
+static void append_str(std::u16string& out, std::u16string_view s) {
+  out.append(s);
+}
+
+template <typename S>
+static void pad(S& out, size_t n) {
+  out.append(n, ' ');
+}
+
+template <typename S>
+static void write_arg(S& out, FormatString::Segment const& seg, ObjPointer const& obj) {
+  char buf[64];
+  char* end = buf;
+
+  std::u16string_view str;
+  char16_t ch;
+
+  bool is_ascii = true;
+
+  switch (obj->type.kind) {
+  case TypeKind::Int:
+    end = std::to_chars(buf, std::end(buf), obj->get_vi(), seg.hex ? 16 : 10).ptr;
+    break;
+
+  case TypeKind::Float:
+    if (seg.precision >= 0)
+      end = std::to_chars(buf, std::end(buf), obj->get_vf(), std::chars_format::fixed,
+                          seg.precision)
+                .ptr;
+    else
+      end = std::to_chars(buf, std::end(buf), obj->get_vf()).ptr;
+    break;
+
+  case TypeKind::Bool: {
+    std::string_view s = obj->get_vb() ? "true" : "false";
+
+    end = buf + s.copy(buf, s.length());
+    break;
+  }
+
+  case TypeKind::Char:
+    ch = obj->get_vc();
+    str = std::u16string_view(&ch, 1);
+    is_ascii = false;
+    break;
+
+  case TypeKind::String:
+    str = obj->As<ObjString>()->View();
+    is_ascii = false;
+    break;
+
+  default: {
+    auto s16 = utils::to_u16string(obj->ToString());
+
+    write_arg(out, seg, ObjNew<ObjString>(std::move(s16)));
+    return;
+  }
+  }
+
+  size_t len = is_ascii ? end - buf : str.length();
+  size_t fill = (size_t)seg.width > len ? seg.width - len : 0;
+
+  if (!seg.left_align)
+    pad(out, fill);
+
+  if (is_ascii)
+    append_ascii(out, buf, end - buf);
+  else
+    append_str(out, str);
+
+  if (seg.left_align)
+    pad(out, fill);
+}
+
+template <typename S>
+static void write(FormatString const& fmt, S& out, ObjPointer const* args) {
+  for (auto&& seg : fmt.segments) {
+    append_str(out, seg.literal);
+
+    if (seg.has_arg)
+      write_arg(out, seg, *args++);
+  }
+}
+
+void FormatString::Write(std::string& out, ObjPointer const* args) const {
+  write(*this, out, args);
+}
+
+void FormatString::Write(std::u16string& out, ObjPointer const* args) const {
+  write(*this, out, args);
+}
+
+} // namespace fire::builtins
@@ -0,0 +1,294 @@
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "IO.h"
+
+namespace fire::io {
+
+static constexpr size_t default_buffer_size = 64 * 1024;
+
+static constexpr size_t line_reader_chunk_size = 1024 * 1024;
+
+void OutputStream::Commit() {
+  if (this->buf.length() >= this->capacity ||
+      (this->line_buffered &&
+       std::memchr(this->buf.data() + this->committed, '\n',
+                   this->buf.length() - this->committed))) {
+    this->Flush();
+  }
+
+  this->committed = this->buf.length();
+}
+
+void OutputStream::Flush() {
+  char const* p = this->buf.data();
+  size_t len = this->buf.length();
+
+  while (len > 0) {
+    auto n = ::write(this->fd, p, len);
+
+    if (n < 0) {
+      if (errno == EINTR)
+        continue;
+
+      break; // cannot write; discard
+    }
+
+    p += n;
+    len -= n;
+  }
+
+  this->buf.clear();
+  this->committed = 0;
+}
+
+void OutputStream::SetBufferSize(size_t size) {
+  this->Flush();
+
+  this->capacity = size;
+  this->buf.reserve(size);
+}
+
+OutputStream::OutputStream(int fd, size_t size, bool line_buffered)
+    : fd(fd),
+      capacity(size),
+      line_buffered(line_buffered) {
+  this->buf.reserve(size);
+}
+
+OutputStream::~OutputStream() {
+  this->Flush();
+}
+
+OutputStream& out() {
+  static OutputStream stream{STDOUT_FILENO, default_buffer_size,
+                             (bool)::isatty(STDOUT_FILENO)};
+
+  return stream;
+}
+
+OutputStream& err() {
+  static OutputStream stream{STDERR_FILENO, 0, false};
+
+  return stream;
+}
+
+//
+// read() or write() until all is done.
+//   returns count of bytes done; less than len at end of file, or if failed.
+template <typename F>
+static size_t do_all(F f, size_t len, bool& failed) {
+  size_t done = 0;
+
+  while (done < len) {
+    auto n = f(done, len - done);
+
+    if (n < 0 && errno == EINTR)
+      continue;
+
+    if (n < 0)
+      failed = true;
+
+    if (n <= 0)
+      break;
+
+    done += n;
+  }
+
+  return done;
+}
+
+bool ReadFile(string const& path, Vec<u8>& out) {
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+  if (fd < 0)
+    return false;
+
+  struct stat st;
+  bool failed = false;
+
+  // size is unknown if not regular file (pipe, /proc); read by chunks.
+  size_t chunk = default_buffer_size;
+
+  if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0)
+    chunk = st.st_size + 1; // +1 to see end of file at once
+
+  out.clear();
+
+  while (!failed) {
+    auto pos = out.size();
+
+    out.resize(pos + chunk);
+
+    auto n = do_all(
+        [&](size_t done, size_t len) { return ::read(fd, out.data() + pos + done, len); },
+        chunk, failed);
+
+    out.resize(pos + n);
+
+    if (n < chunk)
+      break;
+
+    chunk *= 2;
+  }
+
+  ::close(fd);
+
+  return !failed;
+}
+
+bool WriteFile(string const& path, std::span<u8 const> data) {
+  int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+  if (fd < 0)
+    return false;
+
+  bool failed = false;
+
+  auto n = do_all(
+      [&](size_t pos, size_t len) { return ::write(fd, data.data() + pos, len); },
+      data.size(), failed);
+
+  return ::close(fd) == 0 && !failed && n == data.size();
+}
+
+// ----------------------------
+//  MappedFile
+
+std::shared_ptr<MappedFile> MappedFile::Open(string const& path) {
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+  if (fd < 0)
+    return nullptr;
+
+  std::shared_ptr<MappedFile> file{new MappedFile()};
+  struct stat st;
+
+  // size of empty file, or file in /proc is 0; they are read.
+  if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+    void* p = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    if (p != MAP_FAILED) {
+      ::close(fd);
+      ::madvise(p, st.st_size, MADV_SEQUENTIAL);
+
+      file->addr = (u8 const*)p;
+      file->size = st.st_size;
+      file->mapped = true;
+
+      return file;
+    }
+  }
+
+  ::close(fd);
+
+  if (!ReadFile(path, file->data))
+    return nullptr;
+
+  file->addr = file->data.data();
+  file->size = file->data.size();
+
+  return file;
+}
+
+MappedFile::~MappedFile() {
+  if (this->mapped)
+    ::munmap((void*)this->addr, this->size);
+}
+
+// ----------------------------
+//  LineReader
+
+bool LineReader::fill() {
+  if (this->eof)
+    return false;
+
+  // move unread data to front, or grow buffer if it is full of one line.
+  if (this->begin > 0) {
+    std::memmove(this->buf.data(), this->buf.data() + this->begin, this->end - this->begin);
+
+    this->end -= this->begin;
+    this->begin = 0;
+  }
+  else if (this->end == this->buf.size()) {
+    this->buf.resize(this->buf.size() * 2);
+  }
+
+  while (true) {
+    auto n = ::read(this->fd, this->buf.data() + this->end, this->buf.size() - this->end);
+
+    if (n < 0 && errno == EINTR)
+      continue;
+
+    if (n <= 0) {
+      this->eof = true;
+      return false;
+    }
+
+    this->end += n;
+    return true;
+  }
+}
+
+bool LineReader::AtEnd() {
+  return this->begin == this->end && !this->fill();
+}
+
+bool LineReader::Next(std::string_view& line) {
+  size_t searched = this->begin;
+
+  while (true) {
+    auto p = (char const*)std::memchr(this->buf.data() + searched, '\n', this->end - searched);
+
+    if (p) {
+      size_t pos = p - this->buf.data();
+
+      line = {this->buf.data() + this->begin, pos - this->begin};
+      this->begin = pos + 1;
+
+      return true;
+    }
+
+    searched = this->end - this->begin;
+
+    if (!this->fill()) {
+      // last line without '\n'
+      if (this->begin == this->end)
+        return false;
+
+      line = {this->buf.data() + this->begin, this->end - this->begin};
+      this->begin = this->end;
+
+      return true;
+    }
+
+    // fill() moves data to front
+    searched += this->begin;
+  }
+}
+
+std::shared_ptr<LineReader> LineReader::Open(string const& path) {
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+  if (fd < 0)
+    return nullptr;
+
+  ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+  return std::shared_ptr<LineReader>(new LineReader(fd));
+}
+
+LineReader::LineReader(int fd)
+    : fd(fd),
+      buf(line_reader_chunk_size) {
+}
+
+LineReader::~LineReader() {
+  ::close(this->fd);
+}
+
+} // namespace fire::io
@@ -0,0 +1,662 @@
+#include <algorithm>
+#include <cmath>
+
+#include "Kernels.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+  #define KERNELS_X86 1
+#else
+  #define KERNELS_X86 0
+#endif
+
+namespace fire::kernels {
+
+namespace impl {
+
+//
+// 4 lanes (32 bytes).
+//   in AVX2 code it is a ymm register; in SSE2 code a pair of xmm.
+//
+typedef i64 i64x4 __attribute__((vector_size(32)));
+typedef double f64x4 __attribute__((vector_size(32)));
+
+template <typename T>
+struct vec_of;
+
+template <>
+struct vec_of<i64> {
+  using type = i64x4;
+};
+
+template <>
+struct vec_of<double> {
+  using type = f64x4;
+};
+
+template <typename T>
+using V = typename vec_of<T>::type;
+
+constexpr size_t lanes = 4;
+
+//
+// kernels are always inlined into the wrappers below,
+// so they are compiled with the target of each wrapper.
+// (vectors are not passed to functions; that would change the ABI)
+//
+#define KERNEL [[gnu::always_inline]] inline
+
+#define LOAD(_Dst, _Ptr) __builtin_memcpy(&(_Dst), (_Ptr), sizeof(_Dst))
+#define STORE(_Ptr, _Src) __builtin_memcpy((_Ptr), &(_Src), sizeof(_Src))
+
+template <typename T>
+KERNEL T sum(T const* a, size_t n) {
+  V<T> acc0 = {}, acc1 = {};
+  size_t i = 0;
+
+  // two accumulators to hide latency of add
+  for (; i + lanes * 2 <= n; i += lanes * 2) {
+    V<T> x, y;
+
+    LOAD(x, a + i);
+    LOAD(y, a + i + lanes);
+
+    acc0 += x;
+    acc1 += y;
+  }
+
+  acc0 += acc1;
+
+  T s = 0;
+
+  for (size_t k = 0; k < lanes; k++)
+    s += acc0[k];
+
+  for (; i < n; i++)
+    s += a[i];
+
+  return s;
+}
+
+template <typename T, bool IsMax>
+KERNEL T minmax(T const* a, size_t n) {
+  size_t i = 0;
+  T m = a[0];
+
+  if (n >= lanes) {
+    V<T> acc;
+
+    LOAD(acc, a);
+
+    for (i = lanes; i + lanes <= n; i += lanes) {
+      V<T> x;
+
+      LOAD(x, a + i);
+
+      if constexpr (IsMax)
+        acc = x > acc ? x : acc;
+      else
+        acc = x < acc ? x : acc;
+    }
+
+    m = acc[0];
+
+    for (size_t k = 1; k < lanes; k++)
+      m = IsMax ? (acc[k] > m ? acc[k] : m) : (acc[k] < m ? acc[k] : m);
+  }
+
+  for (; i < n; i++)
+    m = IsMax ? (a[i] > m ? a[i] : m) : (a[i] < m ? a[i] : m);
+
+  return m;
+}
+
+template <typename T>
+KERNEL T dot(T const* a, T const* b, size_t n) {
+  V<T> acc = {};
+  size_t i = 0;
+
+  for (; i + lanes <= n; i += lanes) {
+    V<T> x, y;
+
+    LOAD(x, a + i);
+    LOAD(y, b + i);
+
+    acc += x * y;
+  }
+
+  T s = 0;
+
+  for (size_t k = 0; k < lanes; k++)
+    s += acc[k];
+
+  for (; i < n; i++)
+    s += a[i] * b[i];
+
+  return s;
+}
+
+enum class Op {
+  Add,
+  Sub,
+  Mul,
+};
+
+template <typename T, Op op>
+KERNEL void binary(T const* a, T const* b, T* out, size_t n) {
+  size_t i = 0;
+
+  for (; i + lanes <= n; i += lanes) {
+    V<T> x, y, r;
+
+    LOAD(x, a + i);
+    LOAD(y, b + i);
+
+    if constexpr (op == Op::Add)
+      r = x + y;
+    else if constexpr (op == Op::Sub)
+      r = x - y;
+    else
+      r = x * y;
+
+    STORE(out + i, r);
+  }
+
+  for (; i < n; i++) {
+    if constexpr (op == Op::Add)
+      out[i] = a[i] + b[i];
+    else if constexpr (op == Op::Sub)
+      out[i] = a[i] - b[i];
+    else
+      out[i] = a[i] * b[i];
+  }
+}
+
+template <typename T>
+KERNEL void scale(T const* a, T k, T* out, size_t n) {
+  size_t i = 0;
+
+  for (; i + lanes <= n; i += lanes) {
+    V<T> x;
+
+    LOAD(x, a + i);
+
+    x *= k;
+
+    STORE(out + i, x);
+  }
+
+  for (; i < n; i++)
+    out[i] = a[i] * k;
+}
+
+template <typename T>
+KERNEL void clamp(T const* a, T lo, T hi, T* out, size_t n) {
+  V<T> vlo = V<T>{} + lo;
+  V<T> vhi = V<T>{} + hi;
+
+  size_t i = 0;
+
+  for (; i + lanes <= n; i += lanes) {
+    V<T> x;
+
+    LOAD(x, a + i);
+
+    x = x < vlo ? vlo : x;
+    x = x > vhi ? vhi : x;
+
+    STORE(out + i, x);
+  }
+
+  for (; i < n; i++)
+    out[i] = a[i] < lo ? lo : (a[i] > hi ? hi : a[i]);
+}
+
+//
+// block sizes of matmul.
+//   a block of B (kb x mb) is 128 KiB; fits in L2.
+//   a row of it (mb) and a row of C are kept in L1 while looping p.
+//
+constexpr size_t mm_nb = 64;
+constexpr size_t mm_kb = 128;
+constexpr size_t mm_mb = 128;
+
+KERNEL void matmul(double const* a, double const* b, double* c, size_t n, size_t k,
+                   size_t m) {
+  for (size_t i = 0; i < n * m; i++)
+    c[i] = 0;
+
+  for (size_t i0 = 0; i0 < n; i0 += mm_nb) {
+    size_t i1 = std::min(i0 + mm_nb, n);
+
+    for (size_t p0 = 0; p0 < k; p0 += mm_kb) {
+      size_t p1 = std::min(p0 + mm_kb, k);
+
+      for (size_t j0 = 0; j0 < m; j0 += mm_mb) {
+        size_t j1 = std::min(j0 + mm_mb, m);
+
+        for (size_t i = i0; i < i1; i++) {
+          double* crow = c + i * m;
+
+          for (size_t p = p0; p < p1; p++) {
+            // c[i, j..] += a[i, p] * b[p, j..]
+            double x = a[i * k + p];
+            double const* brow = b + p * m;
+
+            size_t j = j0;
+
+            for (; j + lanes <= j1; j += lanes) {
+              V<double> y, z;
+
+              LOAD(y, brow + j);
+              LOAD(z, crow + j);
+
+              z += x * y;
+
+              STORE(crow + j, z);
+            }
+
+            for (; j < j1; j++)
+              crow[j] += x * brow[j];
+          }
+        }
+      }
+    }
+  }
+}
+
+//
+// exp, log, sin, cos
+//
+//  integer part is rounded by adding 1.5 * 2^52; then the low bits of the
+//  result are the integer. (valid while |x| < 2^51)
+//
+constexpr double round_shifter = 0x1.8p52;
+constexpr i64 round_shifter_bits = 0x4338000000000000;
+
+constexpr double ln2_hi = 6.93147180369123816490e-01;
+constexpr double ln2_lo = 1.90821492927058770002e-10;
+
+//
+// elements in lanes which mask is 0 are computed by scalar function.
+//
+#define FALLBACK(_Mask, _Func, _Src, _Dst)                                               \
+  for (size_t k = 0; k < lanes; k++)                                                     \
+    if (!(_Mask)[k])                                                                     \
+      (_Dst)[k] = _Func((_Src)[k]);
+
+//
+// exp(x) = 2^k * exp(r)
+//   k = round(x / ln2),  r = x - k * ln2  (|r| <= ln2 / 2)
+//   exp(r) by Taylor series of degree 13.
+//
+KERNEL void exp(double const* a, double* out, size_t n) {
+  size_t i = 0;
+
+  for (; i + lanes <= n; i += lanes) {
+    V<double> x;
+
+    LOAD(x, a + i);
+
+    // 2^k is a normal number
+    V<i64> ok = (x > -708.0) & (x < 709.0);
+
+    x = ok ? x : V<double>{};
+
+    V<double> t = x * 1.44269504088896338700 + round_shifter;
+    V<double> kd = t - round_shifter;
+    V<i64> ki = (V<i64>)t - round_shifter_bits;
+
+    V<double> r = x - kd * ln2_hi - kd * ln2_lo;
+
+    V<double> p = V<double>{} + 1.0 / 6227020800.0;
+
+    p = p * r + 1.0 / 479001600.0;
+    p = p * r + 1.0 / 39916800.0;
+    p = p * r + 1.0 / 3628800.0;
+    p = p * r + 1.0 / 362880.0;
+    p = p * r + 1.0 / 40320.0;
+    p = p * r + 1.0 / 5040.0;
+    p = p * r + 1.0 / 720.0;
+    p = p * r + 1.0 / 120.0;
+    p = p * r + 1.0 / 24.0;
+    p = p * r + 1.0 / 6.0;
+    p = p * r + 0.5;
+    p = p * r + 1.0;
+    p = p * r + 1.0;
+
+    V<double> y = p * (V<double>)((ki + 1023) << 52);
+
+    FALLBACK(ok, std::exp, a + i, y)
+
+    STORE(out + i, y);
+  }
+
+  for (; i < n; i++)
+    out[i] = std::exp(a[i]);
+}
+
+//
+// log(x) = k * ln2 + log(1 + f)
+//   x = 2^k * (1 + f),  sqrt(2)/2 <= 1 + f < sqrt(2)
+//   log(1 + f) by the minimax polynomial of fdlibm.
+//
+KERNEL void log(double const* a, double* out, size_t n) {
+  constexpr double Lg1 = 6.666666666666735130e-01;
+  constexpr double Lg2 = 3.999999999940941908e-01;
+  constexpr double Lg3 = 2.857142874366239149e-01;
+  constexpr double Lg4 = 2.222219843214978396e-01;
+  constexpr double Lg5 = 1.818357216161805012e-01;
+  constexpr double Lg6 = 1.531383769920937332e-01;
+  constexpr double Lg7 = 1.479819860511658591e-01;
+
+  size_t i = 0;
+
+  for (; i + lanes <= n; i += lanes) {
+    V<double> x;
+
+    LOAD(x, a + i);
+
+    // positive normal number
+    V<i64> ok = (x >= 0x1p-1022) & (x <= 0x1.fffffffffffffp1023);
+
+    x = ok ? x : V<double>{} + 1.0;
+
+    V<i64> bits = (V<i64>)x;
+    V<i64> k = (bits >> 52) - 1023;
+
+    V<double> m = (V<double>)((bits & 0x000fffffffffffff) | 0x3ff0000000000000);
+
+    V<i64> big = m > 1.41421356237309504880;
+
+    m = big ? m * 0.5 : m;
+    k -= big; // big is -1 if true
+
+    V<double> f = m - 1.0;
+    V<double> s = f / (f + 2.0);
+    V<double> z = s * s;
+    V<double> w = z * z;
+
+    V<double> t1 = w * (Lg2 + w * (Lg4 + w * Lg6));
+    V<double> t2 = z * (Lg1 + w * (Lg3 + w * (Lg5 + w * Lg7)));
+    V<double> R = t1 + t2;
+
+    V<double> hfsq = 0.5 * f * f;
+    V<double> dk = __builtin_convertvector(k, V<double>);
+
+    V<double> y = dk * ln2_hi - ((hfsq - (s * (hfsq + R) + dk * ln2_lo)) - f);
+
+    FALLBACK(ok, std::log, a + i, y)
+
+    STORE(out + i, y);
+  }
+
+  for (; i < n; i++)
+    out[i] = std::log(a[i]);
+}
+
+//
+// sin, cos
+//   x = k * pi/2 + r  (|r| <= pi/4)
+//   sin(r), cos(r) by the polynomials of fdlibm, and selected by k mod 4.
+//
+//   pi/2 is split in three parts; k * (each part) is exact while |k| < 2^20.
+//
+template <bool IsCos>
+KERNEL void sincos(double const* a, double* out, size_t n) {
+  constexpr double S1 = -1.66666666666666324348e-01;
+  constexpr double S2 = 8.33333333332248946124e-03;
+  constexpr double S3 = -1.98412698298579493134e-04;
+  constexpr double S4 = 2.75573137070700676789e-06;
+  constexpr double S5 = -2.50507602534068634195e-08;
+  constexpr double S6 = 1.58969099521155010221e-10;
+
+  constexpr double C1 = 4.16666666666666019037e-02;
+  constexpr double C2 = -1.38888888888741095749e-03;
+  constexpr double C3 = 2.48015872894767294178e-05;
+  constexpr double C4 = -2.75573143513906633035e-07;
+  constexpr double C5 = 2.08757232129817482790e-09;
+  constexpr double C6 = -1.13596475577881948265e-11;
+
+  constexpr double pio2_1 = 1.57079632673412561417e+00;
+  constexpr double pio2_2 = 6.07710050630396597660e-11;
+  constexpr double pio2_2t = 2.02226624879595063154e-21;
+
+  size_t i = 0;
+
+  for (; i + lanes <= n; i += lanes) {
+    V<double> x;
+
+    LOAD(x, a + i);
+
+    V<i64> ok = (x > -1e5) & (x < 1e5);
+
+    x = ok ? x : V<double>{};
+
+    V<double> t = x * 6.36619772367581382433e-01 + round_shifter;
+    V<double> kd = t - round_shifter;
+    V<i64> q = ((V<i64>)t - round_shifter_bits) & 3;
+
+    V<double> r = x - kd * pio2_1 - kd * pio2_2 - kd * pio2_2t;
+    V<double> z = r * r;
+
+    V<double> sin_r = r + r * z * (S1 + z * (S2 + z * (S3 + z * (S4 + z * (S5 + z * S6)))));
+    V<double> cos_r =
+        1.0 - 0.5 * z + z * z * (C1 + z * (C2 + z * (C3 + z * (C4 + z * (C5 + z * C6)))));
+
+    V<double> y;
+
+    if constexpr (IsCos) {
+      y = (q & 1) != 0 ? sin_r : cos_r;
+      y = ((q + 1) & 2) != 0 ? -y : y;
+
+      FALLBACK(ok, std::cos, a + i, y)
+    }
+    else {
+      y = (q & 1) != 0 ? cos_r : sin_r;
+      y = (q & 2) != 0 ? -y : y;
+
+      FALLBACK(ok, std::sin, a + i, y)
+    }
+
+    STORE(out + i, y);
+  }
+
+  for (; i < n; i++)
+    out[i] = IsCos ? std::cos(a[i]) : std::sin(a[i]);
+}
+
+#undef FALLBACK
+
+#undef LOAD
+#undef STORE
+#undef KERNEL
+
+} // namespace impl
+
+#if KERNELS_X86
+
+namespace avx2 {
+
+#define AVX2 [[gnu::target("avx2")]]
+
+template <typename T>
+AVX2 T sum(T const* a, size_t n) {
+  return impl::sum(a, n);
+}
+
+template <typename T, bool IsMax>
+AVX2 T minmax(T const* a, size_t n) {
+  return impl::minmax<T, IsMax>(a, n);
+}
+
+template <typename T>
+AVX2 T dot(T const* a, T const* b, size_t n) {
+  return impl::dot(a, b, n);
+}
+
+template <typename T, impl::Op op>
+AVX2 void binary(T const* a, T const* b, T* out, size_t n) {
+  impl::binary<T, op>(a, b, out, n);
+}
+
+template <typename T>
+AVX2 void scale(T const* a, T k, T* out, size_t n) {
+  impl::scale(a, k, out, n);
+}
+
+template <typename T>
+AVX2 void clamp(T const* a, T lo, T hi, T* out, size_t n) {
+  impl::clamp(a, lo, hi, out, n);
+}
+
+AVX2 void matmul(double const* a, double const* b, double* c, size_t n, size_t k,
+                 size_t m) {
+  impl::matmul(a, b, c, n, k, m);
+}
+
+AVX2 void exp(double const* a, double* out, size_t n) {
+  impl::exp(a, out, n);
+}
+
+AVX2 void log(double const* a, double* out, size_t n) {
+  impl::log(a, out, n);
+}
+
+template <bool IsCos>
+AVX2 void sincos(double const* a, double* out, size_t n) {
+  impl::sincos<IsCos>(a, out, n);
+}
+
+#undef AVX2
+
+} // namespace avx2
+
+static bool use_avx2() {
+  static bool const avx2 = __builtin_cpu_supports("avx2");
+
+  return avx2;
+}
+
+#endif
+
+//
+// DISPATCH((args...), func)
+//   call avx2::func if cpu supports AVX2, otherwise impl::func.
+//   (func is last, since it may contain commas of template arguments)
+//
+#if KERNELS_X86
+  #define DISPATCH(_Args, ...)                                                           \
+    if (use_avx2())                                                                      \
+      return avx2::__VA_ARGS__ _Args;                                                    \
+    return impl::__VA_ARGS__ _Args
+#else
+  #define DISPATCH(_Args, ...) return impl::__VA_ARGS__ _Args
+#endif
+
+template <typename T>
+T Sum(T const* a, size_t n) {
+  DISPATCH((a, n), sum);
+}
+
+template <typename T>
+T Min(T const* a, size_t n) {
+  DISPATCH((a, n), minmax<T, false>);
+}
+
+template <typename T>
+T Max(T const* a, size_t n) {
+  DISPATCH((a, n), minmax<T, true>);
+}
+
+template <typename T>
+size_t ArgMax(T const* a, size_t n) {
+  auto m = Max(a, n);
+
+  for (size_t i = 0; i < n; i++)
+    if (a[i] == m)
+      return i;
+
+  return 0; // NaN
+}
+
+template <typename T>
+T Dot(T const* a, T const* b, size_t n) {
+  DISPATCH((a, b, n), dot);
+}
+
+template <typename T>
+void Add(T const* a, T const* b, T* out, size_t n) {
+  DISPATCH((a, b, out, n), binary<T, impl::Op::Add>);
+}
+
+template <typename T>
+void Sub(T const* a, T const* b, T* out, size_t n) {
+  DISPATCH((a, b, out, n), binary<T, impl::Op::Sub>);
+}
+
+template <typename T>
+void Mul(T const* a, T const* b, T* out, size_t n) {
+  DISPATCH((a, b, out, n), binary<T, impl::Op::Mul>);
+}
+
+template <typename T>
+void Scale(T const* a, T k, T* out, size_t n) {
+  DISPATCH((a, k, out, n), scale);
+}
+
+template <typename T>
+void Clamp(T const* a, T lo, T hi, T* out, size_t n) {
+  DISPATCH((a, lo, hi, out, n), clamp);
+}
+
+//
+// each element depends on previous one; not vectorized.
+template <typename T>
+void CumSum(T const* a, T* out, size_t n) {
+  T s = 0;
+
+  for (size_t i = 0; i < n; i++)
+    out[i] = s += a[i];
+}
+
+void MatMul(double const* a, double const* b, double* c, size_t n, size_t k, size_t m) {
+  DISPATCH((a, b, c, n, k, m), matmul);
+}
+
+void Exp(double const* a, double* out, size_t n) {
+  DISPATCH((a, out, n), exp);
+}
+
+void Log(double const* a, double* out, size_t n) {
+  DISPATCH((a, out, n), log);
+}
+
+void Sin(double const* a, double* out, size_t n) {
+  DISPATCH((a, out, n), sincos<false>);
+}
+
+void Cos(double const* a, double* out, size_t n) {
+  DISPATCH((a, out, n), sincos<true>);
+}
+
+#undef DISPATCH
+
+#define INSTANTIATE(T)                                                                   \
+  template T Sum(T const*, size_t);                                                      \
+  template T Min(T const*, size_t);                                                      \
+  template T Max(T const*, size_t);                                                      \
+  template size_t ArgMax(T const*, size_t);                                              \
+  template T Dot(T const*, T const*, size_t);                                            \
+  template void Add(T const*, T const*, T*, size_t);                                     \
+  template void Sub(T const*, T const*, T*, size_t);                                     \
+  template void Mul(T const*, T const*, T*, size_t);                                     \
+  template void Scale(T const*, T, T*, size_t);                                          \
+  template void Clamp(T const*, T, T, T*, size_t);                                       \
+  template void CumSum(T const*, T*, size_t);
+
+INSTANTIATE(i64)
+INSTANTIATE(double)
+
+#undef INSTANTIATE
+
+} // namespace fire::kernels
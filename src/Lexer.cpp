@@ -81,8 +81,8 @@ bool Lexer::Lex(Vec<Token>& out) {
       while (isdigit(this->peek()))
         this->position++;
 
-      // float
-      if (this->eat(".")) {
+      // float  ( but "1..2" is range )
+      if (!this->match("..") && this->eat(".")) {
         tok.kind = TokenKind::Float;
 
         while (isdigit(this->peek()))
@@ -108,8 +108,13 @@ bool Lexer::Lex(Vec<Token>& out) {
 
       tok.kind = is_str ? TokenKind::String : TokenKind::Char;
 
-      while (this->check() && (c = this->peek()) != quat)
+      while (this->check() && (c = this->peek()) != quat) {
+        // skip escaped character (checked in parser)
+        if (c == '\\')
+          this->position++;
+
         this->position++;
+      }
 
       if (!this->check() || !this->eat(quat)) {
         throw Error(tok).format("not terminated %s literal",
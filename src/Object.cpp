@@ -1,8 +1,15 @@
+#include <algorithm>
+#include <bit>
 #include <cassert>
+#include <charconv>
+#include <cstring>
+#include <unordered_map>
 
 #include "alert.h"
 #include "Utils.h"
 #include "Builtin.h"
+#include "Regex.h"
+#include "BTree.h"
 #include "AST.h"
 
 using namespace std::string_literals;
@@ -48,34 +55,429 @@ ObjPointer ObjPrimitive::Clone() const {
 }
 
 std::string ObjPrimitive::ToString() const {
+  std::string ret;
+
+  this->AppendTo(ret);
+
+  return ret;
+}
+
+//
+// numbers are written by std::to_chars.
+//   float is shortest representation which can be round-tripped.
+//
+void ObjPrimitive::AppendTo(std::string& out) const {
+  char buf[32];
+
   switch (this->type.kind) {
   case TypeKind::Int:
-    return std::to_string(this->vi);
+    out.append(buf, std::to_chars(buf, std::end(buf), this->vi).ptr);
+    return;
 
   case TypeKind::Float:
-    return std::to_string(this->vf);
+    out.append(buf, std::to_chars(buf, std::end(buf), this->vf).ptr);
+    return;
 
   case TypeKind::Bool:
-    return this->vb ? "true" : "false";
+    out += this->vb ? "true" : "false";
+    return;
 
-  case TypeKind::Char: {
-    static char16_t _tmp_ch_tbl[2] = {0};
+  case TypeKind::Char:
+    utils::append_u8string(out, std::u16string_view(&this->vc, 1));
+    return;
 
-    _tmp_ch_tbl[0] = this->vc;
-    // _tmp_ch_tbl[1] = 0;
-
-    return utils::to_u8string(_tmp_ch_tbl);
+  case TypeKind::U64:
+    out.append(buf, std::to_chars(buf, std::end(buf), (u64)this->vi).ptr);
+    return;
   }
+
+  if (this->is_fixed_int()) {
+    out.append(buf, std::to_chars(buf, std::end(buf), this->vi).ptr);
+    return;
   }
 
   todo_impl;
 }
 
+//
+// a slice keeps the whole buffer alive.
+// if it's a small part of large buffer, it should be copied when stored.
+//
+static bool is_pinning_buffer(size_t used, size_t total) {
+  return total >= 1024 && used * 4 < total;
+}
+
+//
+// primitives are never modified in place (assignment replaces the pointer),
+// so they can be shared. others are cloned to keep value semantics.
+//
+ObjPointer ObjIterable::CopyElement(ObjPointer const& e) {
+  switch (e->type.kind) {
+  case TypeKind::Int:
+  case TypeKind::Float:
+  case TypeKind::Bool:
+  case TypeKind::Char:
+    return e;
+  }
+
+  if (e->is_fixed_int())
+    return e;
+
+  return e->Clone();
+}
+
+// ----------------------------
+//  unboxed list
+
+static ObjPointer box(i64 v) {
+  return ObjNew<ObjPrimitive>(v);
+}
+
+static ObjPointer box(double v) {
+  return ObjNew<ObjPrimitive>(v);
+}
+
+static ObjPointer box(Bool8 v) {
+  return ObjNew<ObjPrimitive>((bool)v);
+}
+
+static ObjPointer box(char16_t v) {
+  return ObjNew<ObjPrimitive>(v);
+}
+
+//
+// kind of fixed-width integer stored as T
+template <typename T>
+static constexpr TypeKind fixed_int_kind() {
+  if constexpr (std::is_same_v<T, i8>)
+    return TypeKind::I8;
+  else if constexpr (std::is_same_v<T, i16>)
+    return TypeKind::I16;
+  else if constexpr (std::is_same_v<T, i32>)
+    return TypeKind::I32;
+  else if constexpr (std::is_same_v<T, u8>)
+    return TypeKind::U8;
+  else if constexpr (std::is_same_v<T, u16>)
+    return TypeKind::U16;
+  else if constexpr (std::is_same_v<T, u32>)
+    return TypeKind::U32;
+  else
+    return TypeKind::U64;
+}
+
+template <typename T>
+static ObjPointer box(T v) {
+  return ObjNew<ObjPrimitive>(fixed_int_kind<T>(), (i64)v);
+}
+
+template <typename T>
+static T unbox(ObjPointer const& obj) {
+  if constexpr (std::is_same_v<T, i64>)
+    return obj->get_vi();
+  else if constexpr (std::is_same_v<T, double>)
+    return obj->get_vf();
+  else if constexpr (std::is_same_v<T, Bool8>)
+    return (Bool8)obj->get_vb();
+  else if constexpr (std::is_same_v<T, char16_t>)
+    return obj->get_vc();
+  else
+    return (T)obj->as_primitive()->vi;
+}
+
+// write an element without allocating object.
+template <typename T>
+static void append_raw(std::string& out, T v) {
+  if constexpr (std::is_same_v<T, Bool8>)
+    ObjPrimitive((bool)v).AppendTo(out);
+  else if constexpr (std::is_same_v<T, i64> || std::is_same_v<T, double> ||
+                     std::is_same_v<T, char16_t>)
+    ObjPrimitive(v).AppendTo(out);
+  else
+    ObjPrimitive(fixed_int_kind<T>(), (i64)v).AppendTo(out);
+}
+
+static std::shared_ptr<RawList> new_raw_list(TypeKind kind) {
+  switch (kind) {
+  case TypeKind::Int:
+    return std::make_shared<RawList>(Vec<i64>{});
+
+  case TypeKind::Float:
+    return std::make_shared<RawList>(Vec<double>{});
+
+  case TypeKind::Bool:
+    return std::make_shared<RawList>(Vec<Bool8>{});
+
+  case TypeKind::Char:
+    return std::make_shared<RawList>(Vec<char16_t>{});
+
+  case TypeKind::I8:
+    return std::make_shared<RawList>(Vec<i8>{});
+
+  case TypeKind::I16:
+    return std::make_shared<RawList>(Vec<i16>{});
+
+  case TypeKind::I32:
+    return std::make_shared<RawList>(Vec<i32>{});
+
+  case TypeKind::U8:
+    return std::make_shared<RawList>(Vec<u8>{});
+
+  case TypeKind::U16:
+    return std::make_shared<RawList>(Vec<u16>{});
+
+  case TypeKind::U32:
+    return std::make_shared<RawList>(Vec<u32>{});
+
+  case TypeKind::U64:
+    return std::make_shared<RawList>(Vec<u64>{});
+  }
+
+  return nullptr;
+}
+
+// ----------------------------
+//  ObjIterable
+
+bool ObjIterable::IsUnboxedType(TypeKind kind) {
+  switch (kind) {
+  case TypeKind::Int:
+  case TypeKind::Float:
+  case TypeKind::Bool:
+  case TypeKind::Char:
+  case TypeKind::I8:
+  case TypeKind::I16:
+  case TypeKind::I32:
+  case TypeKind::U8:
+  case TypeKind::U16:
+  case TypeKind::U32:
+  case TypeKind::U64:
+    return true;
+  }
+
+  return false;
+}
+
+size_t ObjIterable::buffer_size() const {
+  if (this->_raw)
+    return std::visit([](auto const& v) { return v.size(); }, *this->_raw);
+
+  return this->_list->size();
+}
+
+size_t ObjIterable::Capacity() const {
+  if (this->_is_slice)
+    return this->_count;
+
+  if (this->_raw)
+    return std::visit([](auto const& v) { return v.capacity(); }, *this->_raw);
+
+  return this->_list->capacity();
+}
+
+void ObjIterable::Detach() {
+  if (!this->IsShared())
+    return;
+
+  if (this->_raw) {
+    auto copy = std::visit(
+        [this](auto const& v) {
+          using V = std::decay_t<decltype(v)>;
+
+          V ret;
+
+          ret.reserve(this->Capacity());
+          ret.assign(v.begin() + this->_offset, v.begin() + this->_offset + this->Count());
+
+          return std::make_shared<RawList>(std::move(ret));
+        },
+        *this->_raw);
+
+    this->_raw = std::move(copy);
+  }
+  else {
+    auto src = this->GetList();
+    auto copy = std::make_shared<ObjVector>();
+
+    copy->reserve(this->Capacity());
+
+    for (auto&& e : src)
+      copy->emplace_back(CopyElement(e));
+
+    this->_list = std::move(copy);
+  }
+
+  this->_is_slice = false;
+  this->_offset = 0;
+}
+
+ObjPointer ObjIterable::At(size_t index) const {
+  if (!this->_raw)
+    return this->GetList()[index];
+
+  return std::visit([index, this](auto const& v) { return box(v[this->_offset + index]); },
+                    *this->_raw);
+}
+
+void ObjIterable::Set(size_t index, ObjPointer obj) {
+  if (!this->_raw) {
+    this->GetMutableList()[index] = std::move(obj);
+    return;
+  }
+
+  this->Detach();
+
+  std::visit(
+      [&](auto& v) {
+        using T = typename std::decay_t<decltype(v)>::value_type;
+
+        v[index] = unbox<T>(obj);
+      },
+      *this->_raw);
+}
+
+void ObjIterable::Append(ObjPointer const& obj) {
+  if (!this->_raw) {
+    this->GetMutableList().emplace_back(obj);
+    return;
+  }
+
+  this->Detach();
+
+  std::visit(
+      [&](auto& v) {
+        using T = typename std::decay_t<decltype(v)>::value_type;
+
+        v.emplace_back(unbox<T>(obj));
+      },
+      *this->_raw);
+}
+
+void ObjIterable::AppendList(ObjPtr<ObjIterable> obj) {
+  // obj may be same as this.
+  //   holding the list makes it shared, so Detach() copies it.
+  auto hold = obj->_list;
+  auto hold_raw = obj->_raw;
+
+  if (this->_raw && obj->_raw && this->_raw->index() == obj->_raw->index()) {
+    this->Detach();
+
+    std::visit(
+        [&](auto& v) {
+          using T = typename std::decay_t<decltype(v)>::value_type;
+
+          auto src = obj->GetRaw<T>();
+
+          if (size_t needed = v.size() + src.size(); v.capacity() < needed)
+            v.reserve(std::max(needed, v.capacity() * 2));
+
+          v.insert(v.end(), src.begin(), src.end());
+        },
+        *this->_raw);
+
+    return;
+  }
+
+  if (!this->_raw && !obj->_raw) {
+    auto src = obj->GetList();
+    auto& list = this->GetMutableList();
+
+    // keep geometric growth, for appending repeatedly.
+    if (size_t needed = list.size() + src.size(); list.capacity() < needed)
+      list.reserve(std::max(needed, list.capacity() * 2));
+
+    for (auto&& e : src)
+      list.emplace_back(CopyElement(e));
+
+    return;
+  }
+
+  for (size_t i = 0, n = obj->Count(); i < n; i++)
+    this->Append(CopyElement(obj->At(i)));
+}
+
+void ObjIterable::Insert(size_t index, ObjPointer const& obj) {
+  if (!this->_raw) {
+    auto& list = this->GetMutableList();
+
+    list.insert(list.begin() + index, obj);
+    return;
+  }
+
+  this->Detach();
+
+  std::visit(
+      [&](auto& v) {
+        using T = typename std::decay_t<decltype(v)>::value_type;
+
+        v.insert(v.begin() + index, unbox<T>(obj));
+      },
+      *this->_raw);
+}
+
+ObjPointer ObjIterable::Pop() {
+  if (!this->_raw) {
+    auto& list = this->GetMutableList();
+    auto obj = std::move(list.back());
+
+    list.pop_back();
+
+    return obj;
+  }
+
+  this->Detach();
+
+  return std::visit(
+      [](auto& v) {
+        auto obj = box(v.back());
+
+        v.pop_back();
+
+        return obj;
+      },
+      *this->_raw);
+}
+
+void ObjIterable::Reserve(size_t count) {
+  this->Detach();
+
+  if (this->_raw)
+    std::visit([count](auto& v) { v.reserve(count); }, *this->_raw);
+  else
+    this->_list->reserve(count);
+}
+
+void ObjIterable::Clear() {
+  this->Detach();
+
+  if (this->_raw)
+    std::visit([](auto& v) { v.clear(); }, *this->_raw);
+  else
+    this->_list->clear();
+}
+
+ObjPtr<ObjIterable> ObjIterable::Slice(size_t begin, size_t end) const {
+  auto obj = ObjNew<ObjIterable>(this->type);
+
+  obj->_list = this->_list;
+  obj->_raw = this->_raw;
+  obj->_is_slice = true;
+  obj->_offset = this->_offset + begin;
+  obj->_count = end - begin;
+
+  return obj;
+}
+
 ObjPointer ObjIterable::Clone() const {
   auto obj = ObjNew<ObjIterable>(this->type);
 
-  for (auto&& x : this->list)
-    obj->Append(x->Clone());
+  obj->_list = this->_list;
+  obj->_raw = this->_raw;
+  obj->_is_slice = this->_is_slice;
+  obj->_offset = this->_offset;
+  obj->_count = this->_count;
+
+  if (this->_is_slice && is_pinning_buffer(this->_count, this->buffer_size()))
+    obj->Detach();
 
   return obj;
 }
@@ -83,36 +485,173 @@ ObjPointer ObjIterable::Clone() const {
 std::string ObjIterable::ToString() const {
   std::string ret;
 
-  for (auto it = this->list.begin(); it != this->list.end(); it++) {
+  if (this->_raw) {
+    this->AppendTo(ret);
+    return ret;
+  }
+
+  auto const& list = this->GetList();
+
+  for (auto it = list.begin(); it != list.end(); it++) {
     ret += (*it)->ToString();
-    if (it < this->list.end() - 1)
+    if (it < list.end() - 1)
       ret += ", ";
   }
 
   return "[" + ret + "]";
 }
 
+void ObjIterable::AppendTo(std::string& out) const {
+  out += '[';
+
+  if (this->_raw) {
+    std::visit(
+        [&](auto const& v) {
+          using T = typename std::decay_t<decltype(v)>::value_type;
+
+          auto list = this->GetRaw<T>();
+
+          for (size_t i = 0; i < list.size(); i++) {
+            if (i > 0)
+              out += ", ";
+
+            append_raw(out, list[i]);
+          }
+        },
+        *this->_raw);
+  }
+  else {
+    auto const& list = this->GetList();
+
+    for (size_t i = 0; i < list.size(); i++) {
+      if (i > 0)
+        out += ", ";
+
+      list[i]->AppendTo(out);
+    }
+  }
+
+  out += ']';
+}
+
+bool ObjIterable::Equals(ObjPointer obj) const {
+  if (!obj->type.is_iterable())
+    return false;
+
+  auto x = obj->As<ObjIterable>();
+
+  if (this->Count() != x->Count())
+    return false;
+
+  if (this->_raw && x->_raw && this->_raw->index() == x->_raw->index()) {
+    return std::visit(
+        [&](auto const& v) {
+          using T = typename std::decay_t<decltype(v)>::value_type;
+
+          auto a = this->GetRaw<T>();
+          auto b = x->GetRaw<T>();
+
+          return std::equal(a.begin(), a.end(), b.begin());
+        },
+        *this->_raw);
+  }
+
+  if (!this->_raw && !x->_raw) {
+    auto list = this->GetList();
+    auto other = x->GetList();
+
+    if (list.data() == other.data())
+      return true;
+
+    for (auto it = list.begin(); auto&& e : other)
+      if (!(*it++)->Equals(e))
+        return false;
+
+    return true;
+  }
+
+  for (size_t i = 0; i < this->Count(); i++)
+    if (!this->At(i)->Equals(x->At(i)))
+      return false;
+
+  return true;
+}
+
+ObjIterable::ObjIterable(TypeInfo type)
+    : Object(std::move(type)) {
+  if (!this->type.params.empty() && IsUnboxedType(this->type.params[0].kind))
+    this->_raw = new_raw_list(this->type.params[0].kind);
+  else
+    this->_list = std::make_shared<ObjVector>();
+}
+
 // ----------------------------
-//  ObjString
+//  ObjTuple
 
-ObjPointer ObjString::SubString(size_t pos, size_t length) {
-  auto obj = ObjNew<ObjString>();
+std::string ObjTuple::ToString() const {
+  std::string ret = "(";
+
+  for (size_t i = 0; i < this->_count; i++) {
+    if (i >= 1)
+      ret += ", ";
 
-  for (size_t i = pos, end = pos + (length == 0 ? this->list.size() - pos : length);
-       i < end; i++) {
-    obj->Append(this->list[i]->Clone());
+    ret += this->At(i)->ToStringAsMember();
   }
 
+  return ret + (this->_count == 1 ? ",)" : ")");
+}
+
+ObjPointer ObjTuple::Clone() const {
+  auto obj = ObjNew<ObjTuple>(this->type);
+
+  for (size_t i = 0; i < this->_count; i++)
+    obj->At(i) = ObjIterable::CopyElement(this->At(i));
+
   return obj;
 }
 
-std::string ObjString::ToString() const {
-  std::u16string temp;
+bool ObjTuple::Equals(ObjPointer obj) const {
+  if (!obj->is_tuple())
+    return false;
+
+  auto x = obj->As<ObjTuple>();
+
+  if (this->_count != x->_count)
+    return false;
+
+  for (size_t i = 0; i < this->_count; i++)
+    if (!this->At(i)->Equals(x->At(i)))
+      return false;
+
+  return true;
+}
+
+ObjTuple::ObjTuple(TypeInfo type)
+    : Object(std::move(type)),
+      _count(this->type.params.size()) {
+  if (this->_count > inline_count)
+    this->_ext = std::make_unique<ObjPointer[]>(this->_count);
+}
+
+// ----------------------------
+//  ObjString
 
-  for (auto&& c : this->list)
-    temp.push_back(c->As<ObjPrimitive>()->vc);
+ObjPtr<ObjString> ObjString::SubString(size_t pos, size_t length) const {
+  auto obj = ObjNew<ObjString>(this->_buf);
 
-  return utils::to_u8string(temp);
+  obj->_is_slice = true;
+  obj->_offset = this->_offset + pos;
+  obj->_length = std::min(length, this->Length() - pos);
+
+  return obj;
+}
+
+std::string ObjString::ToString() const {
+  return utils::to_u8string(this->View());
+}
+
+void ObjString::AppendTo(std::string& out) const {
+  utils::append_u8string(out, this->View());
 }
 
 std::string ObjString::ToStringAsMember() const {
@@ -122,23 +661,1128 @@ std::string ObjString::ToStringAsMember() const {
 ObjPointer ObjString::Clone() const {
   auto obj = ObjNew<ObjString>();
 
-  for (auto&& c : this->list) {
-    obj->Append(c->Clone());
+  obj->_hash = this->_hash;
+  obj->_hash_cached = this->_hash_cached;
+  obj->_interned = this->_interned;
+
+  if (this->_is_slice && is_pinning_buffer(this->_length, this->_buf->length())) {
+    obj->_buf = std::make_shared<std::u16string>(this->View());
+  }
+  else {
+    obj->_buf = this->_buf;
+    obj->_is_slice = this->_is_slice;
+    obj->_offset = this->_offset;
+    obj->_length = this->_length;
+  }
+
+  return obj;
+}
+
+size_t ObjString::Hash() const {
+  if (!this->_hash_cached) {
+    this->_hash = std::hash<std::u16string_view>{}(this->View());
+    this->_hash_cached = true;
+  }
+
+  return this->_hash;
+}
+
+bool ObjString::Equals(ObjPointer obj) const {
+  if (!obj->is_string())
+    return false;
+
+  auto x = obj->As<ObjString>();
+
+  if (this->_buf == x->_buf && this->_offset == x->_offset &&
+      this->Length() == x->Length())
+    return true;
+
+  // 内容が同じ intern 済み文字列は必ずバッファを共有している
+  if (this->_interned && x->_interned)
+    return false;
+
+  if (this->Length() != x->Length())
+    return false;
+
+  //
+  // one side has a cached hash (literal, or compared before):
+  //   compute hash of the other side (cached too), and compare it at first.
+  if ((this->_hash_cached || x->_hash_cached) && this->Hash() != x->Hash())
+    return false;
+
+  return this->View() == x->View();
+}
+
+ObjPtr<ObjString> ObjString::Intern(std::u16string_view str) {
+  struct Entry {
+    std::shared_ptr<std::u16string> buf;
+    size_t hash;
+  };
+
+  // key is a view to the buffer in entry.
+  static std::unordered_map<std::u16string_view, Entry> table;
+
+  auto it = table.find(str);
+
+  if (it == table.end()) {
+    auto buf = std::make_shared<std::u16string>(str);
+
+    it = table.emplace(*buf, Entry{buf, std::hash<std::u16string_view>{}(*buf)}).first;
   }
 
+  auto obj = ObjNew<ObjString>();
+
+  obj->_buf = it->second.buf;
+  obj->_hash = it->second.hash;
+  obj->_hash_cached = true;
+  obj->_interned = true;
+
   return obj;
 }
 
 ObjString::ObjString(std::u16string const& str)
-    : ObjIterable(TypeKind::String) {
-  for (auto&& c : str)
-    this->Append(ObjNew<ObjPrimitive>(c));
+    : Object(TypeKind::String),
+      _buf(std::make_shared<std::u16string>(str)) {
+}
+
+ObjString::ObjString(std::u16string&& str)
+    : Object(TypeKind::String),
+      _buf(std::make_shared<std::u16string>(std::move(str))) {
 }
 
 ObjString::ObjString(std::string const& str)
     : ObjString(utils::to_u16string(str)) {
 }
 
+ObjString::ObjString(std::shared_ptr<std::u16string> buf)
+    : Object(TypeKind::String),
+      _buf(std::move(buf)) {
+}
+
+std::u16string& ObjString::GetMutable() {
+  if (this->_is_slice || this->_buf.use_count() > 1) {
+    this->_buf = std::make_shared<std::u16string>(this->View());
+    this->_is_slice = false;
+    this->_offset = 0;
+  }
+
+  this->_hash_cached = false;
+  this->_interned = false;
+
+  return *this->_buf;
+}
+
+// ----------------------------
+//  ObjStringBuilder
+
+std::u16string& ObjStringBuilder::GetMutable() {
+  if (this->_buf.use_count() > 1) {
+    auto buf = std::make_shared<std::u16string>();
+
+    buf->reserve(this->_buf->capacity());
+    buf->append(*this->_buf);
+
+    this->_buf = std::move(buf);
+  }
+
+  return *this->_buf;
+}
+
+void ObjStringBuilder::Append(std::u16string_view str) {
+  this->GetMutable().append(str);
+}
+
+void ObjStringBuilder::Append(char16_t c) {
+  this->GetMutable().push_back(c);
+}
+
+void ObjStringBuilder::Reserve(size_t size) {
+  this->GetMutable().reserve(size);
+}
+
+void ObjStringBuilder::Clear() {
+  if (this->_buf.use_count() > 1)
+    this->_buf = std::make_shared<std::u16string>();
+  else
+    this->_buf->clear();
+}
+
+ObjPtr<ObjString> ObjStringBuilder::Build() {
+  return ObjNew<ObjString>(this->_buf);
+}
+
+std::string ObjStringBuilder::ToString() const {
+  return utils::to_u8string(*this->_buf);
+}
+
+void ObjStringBuilder::AppendTo(std::string& out) const {
+  utils::append_u8string(out, *this->_buf);
+}
+
+ObjPointer ObjStringBuilder::Clone() const {
+  auto obj = ObjNew<ObjStringBuilder>();
+
+  obj->_buf = this->_buf;
+
+  return obj;
+}
+
+ObjStringBuilder::ObjStringBuilder()
+    : Object(TypeKind::StringBuilder),
+      _buf(std::make_shared<std::u16string>()) {
+}
+
+// ----------------------------
+//  ObjRegex
+
+std::string ObjRegex::ToString() const {
+  return "regex(\"" + utils::to_u8string(this->re->GetPattern()) + "\")";
+}
+
+ObjRegex::ObjRegex(std::shared_ptr<regex::Regex> re)
+    : Object(TypeKind::Regex),
+      re(std::move(re)) {
+}
+
+// ----------------------------
+//  ObjDict
+
+namespace {
+
+//
+// control byte:
+//   0xxxxxxx  full (7 bits of hash)
+//   10000000  empty
+//   11111110  deleted
+//
+constexpr u8 ctrl_empty = 0x80;
+constexpr u8 ctrl_deleted = 0xFE;
+
+constexpr size_t group_width = 8;
+
+constexpr u64 lsbs = 0x0101010101010101ull;
+constexpr u64 msbs = 0x8080808080808080ull;
+
+//
+// group of 8 control bytes.
+//   bit 7 of each byte is set in result of match_xxx(). (little endian)
+inline u64 load_group(u8 const* p) {
+  u64 g;
+
+  std::memcpy(&g, p, sizeof(g));
+
+  return g;
+}
+
+// may have false positive; keys are compared after this.
+inline u64 match_byte(u64 g, u8 h2) {
+  auto x = g ^ (lsbs * h2);
+
+  return (x - lsbs) & ~x & msbs;
+}
+
+inline u64 match_empty(u64 g) {
+  return g & ~(g << 6) & msbs;
+}
+
+inline u64 match_empty_or_deleted(u64 g) {
+  return g & ~(g << 7) & msbs;
+}
+
+inline size_t lowest_index(u64 mask) {
+  return (size_t)std::countr_zero(mask) >> 3;
+}
+
+// max count of slots in use (7/8)
+inline size_t max_load(size_t capacity) {
+  return capacity - capacity / 8;
+}
+
+inline size_t capacity_for(size_t count) {
+  size_t cap = group_width;
+
+  while (max_load(cap) <= count)
+    cap *= 2;
+
+  return cap;
+}
+
+inline size_t mix_hash(u64 x) {
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdull;
+  x ^= x >> 33;
+  x *= 0xc4ceb9fe1a85ec53ull;
+  x ^= x >> 33;
+
+  return x;
+}
+
+size_t hash_key(ObjPointer const& key) {
+  switch (key->type.kind) {
+  case TypeKind::Int:
+    return mix_hash((u64)key->get_vi());
+
+  case TypeKind::Char:
+    return mix_hash(key->get_vc());
+
+  case TypeKind::Bool:
+    return mix_hash(key->get_vb());
+
+  case TypeKind::String:
+    return key->As<ObjString>()->Hash();
+
+  case TypeKind::Enumerator: {
+    auto e = key->As<ObjEnumerator>();
+
+    return mix_hash((u64)&*e->ast ^ (u64)e->index);
+  }
+  }
+
+  // instance: identity
+  return mix_hash((u64)&*key);
+}
+
+bool key_equals(ObjPointer const& a, ObjPointer const& b) {
+  switch (a->type.kind) {
+  case TypeKind::Int:
+    return a->get_vi() == b->get_vi();
+
+  case TypeKind::Char:
+    return a->get_vc() == b->get_vc();
+
+  case TypeKind::Bool:
+    return a->get_vb() == b->get_vb();
+
+  case TypeKind::String:
+  case TypeKind::Enumerator:
+    return a->Equals(b);
+  }
+
+  return a == b;
+}
+
+} // namespace
+
+bool ObjDict::IsHashableType(TypeInfo const& type) {
+  switch (type.kind) {
+  case TypeKind::Int:
+  case TypeKind::Char:
+  case TypeKind::Bool:
+  case TypeKind::String:
+  case TypeKind::Enumerator:
+  case TypeKind::Instance:
+    return true;
+  }
+
+  return false;
+}
+
+ObjDict::Table& ObjDict::GetMutable() {
+  if (this->_table.use_count() >= 2) {
+    auto copy = std::make_shared<Table>(*this->_table);
+
+    for (auto&& e : copy->entries)
+      if (e.key)
+        e.value = ObjIterable::CopyElement(e.value);
+
+    this->_table = std::move(copy);
+  }
+
+  return *this->_table;
+}
+
+static void set_ctrl(Vec<u8>& ctrl, size_t capacity, size_t slot, u8 c) {
+  ctrl[slot] = c;
+
+  if (slot < group_width)
+    ctrl[capacity + slot] = c;
+}
+
+static size_t find_free_slot(Vec<u8> const& ctrl, size_t capacity, size_t hash) {
+  size_t mask = capacity - 1;
+
+  for (size_t pos = (hash >> 7) & mask, step = 0;;) {
+    if (u64 m = match_empty_or_deleted(load_group(&ctrl[pos])); m)
+      return (pos + lowest_index(m)) & mask;
+
+    step += group_width;
+    pos = (pos + step) & mask;
+  }
+}
+
+size_t ObjDict::FindSlot(ObjPointer const& key, size_t hash) const {
+  auto const& t = *this->_table;
+
+  if (t.slots.empty())
+    return std::string::npos;
+
+  size_t mask = t.slots.size() - 1;
+  u8 h2 = hash & 0x7F;
+
+  for (size_t pos = (hash >> 7) & mask, step = 0;;) {
+    u64 g = load_group(&t.ctrl[pos]);
+
+    for (u64 m = match_byte(g, h2); m; m &= m - 1) {
+      size_t slot = (pos + lowest_index(m)) & mask;
+      auto const& e = t.entries[t.slots[slot]];
+
+      if (e.hash == hash && key_equals(e.key, key))
+        return slot;
+    }
+
+    if (match_empty(g))
+      return std::string::npos;
+
+    step += group_width;
+    pos = (pos + step) & mask;
+  }
+}
+
+//
+// removed entries are dropped, and all slots are rebuilt.
+//
+void ObjDict::Rehash(size_t capacity) {
+  auto& t = this->GetMutable();
+
+  if (t.removed != 0) {
+    std::erase_if(t.entries, [](Entry const& e) {
+      return !e.key;
+    });
+
+    t.removed = 0;
+  }
+
+  t.ctrl.assign(capacity + group_width, ctrl_empty);
+  t.slots.assign(capacity, 0);
+
+  for (u32 i = 0; i < t.entries.size(); i++) {
+    auto hash = t.entries[i].hash;
+    auto slot = find_free_slot(t.ctrl, capacity, hash);
+
+    set_ctrl(t.ctrl, capacity, slot, hash & 0x7F);
+    t.slots[slot] = i;
+  }
+}
+
+ObjPointer const* ObjDict::Find(ObjPointer const& key) const {
+  auto slot = this->FindSlot(key, hash_key(key));
+
+  if (slot == std::string::npos)
+    return nullptr;
+
+  return &this->_table->entries[this->_table->slots[slot]].value;
+}
+
+ObjPointer& ObjDict::GetOrInsert(ObjPointer const& key) {
+  auto hash = hash_key(key);
+
+  if (auto slot = this->FindSlot(key, hash); slot != std::string::npos) {
+    auto& t = this->GetMutable();
+
+    return t.entries[t.slots[slot]].value;
+  }
+
+  auto& t = this->GetMutable();
+  auto capacity = t.slots.size();
+
+  //
+  // every entry (includes removed) has used one slot at least.
+  // so there is an empty slot while the entries are less than max load.
+  if (t.entries.size() >= max_load(capacity)) {
+    // many of entries are removed: compact in same capacity.
+    if (capacity == 0 || t.count * 32 > capacity * 25)
+      capacity = capacity_for(t.count + 1);
+
+    this->Rehash(capacity);
+  }
+
+  auto slot = find_free_slot(t.ctrl, capacity, hash);
+
+  set_ctrl(t.ctrl, capacity, slot, hash & 0x7F);
+  t.slots[slot] = (u32)t.entries.size();
+  t.count++;
+
+  // strings are copied (they are mutable); key in table must not be changed.
+  // none is immutable; one object is shared by all new entries.
+  static auto const none = ObjNew<ObjNone>();
+
+  auto& e = t.entries.emplace_back(
+      Entry{key->is_string() ? key->Clone() : key, none, hash});
+
+  return e.value;
+}
+
+bool ObjDict::Remove(ObjPointer const& key) {
+  auto slot = this->FindSlot(key, hash_key(key));
+
+  if (slot == std::string::npos)
+    return false;
+
+  auto& t = this->GetMutable();
+  auto& e = t.entries[t.slots[slot]];
+
+  e.key = nullptr;
+  e.value = nullptr;
+
+  set_ctrl(t.ctrl, t.slots.size(), slot, ctrl_deleted);
+
+  t.count--;
+  t.removed++;
+
+  return true;
+}
+
+void ObjDict::Reserve(size_t count) {
+  if (count != 0 && count >= max_load(this->_table->slots.size()))
+    this->Rehash(capacity_for(count));
+
+  this->GetMutable().entries.reserve(count);
+}
+
+void ObjDict::Clear() {
+  this->_table = std::make_shared<Table>();
+}
+
+std::string ObjDict::ToString() const {
+  std::string ret = "{";
+
+  this->ForEach([&ret](ObjPointer const& k, ObjPointer const& v) {
+    if (ret.length() > 1)
+      ret += ", ";
+
+    ret += k->ToStringAsMember() + ": " + v->ToStringAsMember();
+  });
+
+  return ret + "}";
+}
+
+ObjPointer ObjDict::Clone() const {
+  auto obj = ObjNew<ObjDict>(this->type);
+
+  obj->_table = this->_table;
+
+  return obj;
+}
+
+bool ObjDict::Equals(ObjPointer obj) const {
+  if (obj->type.kind != this->type.kind)
+    return false;
+
+  auto x = obj->As<ObjDict>();
+
+  if (this->_table == x->_table)
+    return true;
+
+  if (this->Count() != x->Count())
+    return false;
+
+  for (auto&& e : this->_table->entries) {
+    if (!e.key)
+      continue;
+
+    auto v = x->Find(e.key);
+
+    if (!v || !e.value->Equals(*v))
+      return false;
+  }
+
+  return true;
+}
+
+ObjDict::ObjDict(TypeInfo type)
+    : Object(std::move(type)),
+      _table(std::make_shared<Table>()) {
+}
+
+// ----------------------------
+//  ObjSet
+
+std::string ObjSet::ToString() const {
+  std::string ret = "{";
+
+  this->ForEach([&ret](ObjPointer const& k, ObjPointer const&) {
+    if (ret.length() > 1)
+      ret += ", ";
+
+    ret += k->ToStringAsMember();
+  });
+
+  return ret + "}";
+}
+
+ObjPointer ObjSet::Clone() const {
+  auto obj = ObjNew<ObjSet>(this->type);
+
+  obj->_table = this->_table;
+
+  return obj;
+}
+
+ObjSet::ObjSet(TypeInfo type)
+    : ObjDict(std::move(type)) {
+}
+
+// ----------------------------
+//  ObjBitSet
+
+size_t ObjBitSet::Count() const {
+  size_t n = 0;
+
+  for (auto w : this->words)
+    n += std::popcount(w);
+
+  return n;
+}
+
+size_t ObjBitSet::FindNext(size_t from) const {
+  if (from >= this->size)
+    return this->size;
+
+  size_t i = from / 64;
+
+  // bits before "from" are masked
+  u64 w = this->words[i] & (~u64(0) << (from % 64));
+
+  while (w == 0) {
+    if (++i >= this->words.size())
+      return this->size;
+
+    w = this->words[i];
+  }
+
+  return i * 64 + std::countr_zero(w);
+}
+
+std::string ObjBitSet::ToString() const {
+  std::string ret = "bitset{";
+
+  for (size_t i = this->FindNext(0); i < this->size; i = this->FindNext(i + 1)) {
+    if (ret.back() != '{')
+      ret += ", ";
+
+    ret += std::to_string(i);
+  }
+
+  return ret + "}";
+}
+
+ObjPointer ObjBitSet::Clone() const {
+  auto obj = ObjNew<ObjBitSet>(0);
+
+  obj->words = this->words;
+  obj->size = this->size;
+
+  return obj;
+}
+
+bool ObjBitSet::Equals(ObjPointer obj) const {
+  if (obj->type.kind != TypeKind::BitSet)
+    return false;
+
+  auto x = obj->As<ObjBitSet>();
+
+  return this->size == x->size && this->words == x->words;
+}
+
+ObjBitSet::ObjBitSet(size_t size)
+    : Object(TypeKind::BitSet),
+      words((size + 63) / 64),
+      size(size) {
+}
+
+// ----------------------------
+//  ObjOrderedMap
+
+btree::BTree& ObjOrderedMap::GetMutable() {
+  if (this->_tree.use_count() >= 2)
+    this->_tree = std::make_shared<btree::BTree>(*this->_tree);
+
+  return *this->_tree;
+}
+
+std::string ObjOrderedMap::ToString() const {
+  std::string ret = "{";
+
+  for (auto cur = this->_tree->Begin(); !cur.IsEnd(); cur.Next()) {
+    if (ret.length() > 1)
+      ret += ", ";
+
+    ret += cur.GetKey()->ToStringAsMember() + ": " + cur.GetValue()->ToStringAsMember();
+  }
+
+  return ret + "}";
+}
+
+ObjPointer ObjOrderedMap::Clone() const {
+  auto obj = ObjNew<ObjOrderedMap>(this->type);
+
+  obj->_tree = this->_tree;
+
+  return obj;
+}
+
+bool ObjOrderedMap::Equals(ObjPointer obj) const {
+  if (!obj->is_ordered_map())
+    return false;
+
+  auto const& a = *this->_tree;
+  auto const& b = *obj->As<ObjOrderedMap>()->_tree;
+
+  if (&a == &b)
+    return true;
+
+  if (a.Count() != b.Count())
+    return false;
+
+  for (auto x = a.Begin(), y = b.Begin(); !x.IsEnd(); x.Next(), y.Next()) {
+    if (!x.GetKey()->Equals(y.GetKey()) || !x.GetValue()->Equals(y.GetValue()))
+      return false;
+  }
+
+  return true;
+}
+
+ObjOrderedMap::ObjOrderedMap(TypeInfo type)
+    : Object(std::move(type)),
+      _tree(std::make_shared<btree::BTree>(this->type.params[0].kind)) {
+}
+
+// ----------------------------
+//  ObjDeque
+
+ObjDeque::Ring& ObjDeque::GetMutable() {
+  if (this->_ring.use_count() >= 2) {
+    auto& src = *this->_ring;
+    auto copy = std::make_shared<Ring>();
+
+    copy->buf.resize(src.buf.size());
+    copy->count = src.count;
+
+    for (size_t i = 0; i < src.count; i++)
+      copy->buf[i] = ObjIterable::CopyElement(src.At(i));
+
+    this->_ring = std::move(copy);
+  }
+
+  return *this->_ring;
+}
+
+void ObjDeque::Grow(Ring& r) {
+  if (r.count < r.buf.size())
+    return;
+
+  Vec<ObjPointer> buf(std::max<size_t>(8, r.buf.size() * 2));
+
+  for (size_t i = 0; i < r.count; i++)
+    buf[i] = std::move(r.At(i));
+
+  r.buf = std::move(buf);
+  r.head = 0;
+}
+
+void ObjDeque::PushBack(ObjPointer obj) {
+  auto& r = this->GetMutable();
+
+  this->Grow(r);
+
+  r.At(r.count++) = std::move(obj);
+}
+
+void ObjDeque::PushFront(ObjPointer obj) {
+  auto& r = this->GetMutable();
+
+  this->Grow(r);
+
+  r.head = (r.head - 1) & (r.buf.size() - 1);
+  r.buf[r.head] = std::move(obj);
+  r.count++;
+}
+
+ObjPointer ObjDeque::PopBack() {
+  auto& r = this->GetMutable();
+
+  return std::move(r.At(--r.count));
+}
+
+ObjPointer ObjDeque::PopFront() {
+  auto& r = this->GetMutable();
+  auto obj = std::move(r.buf[r.head]);
+
+  r.head = (r.head + 1) & (r.buf.size() - 1);
+  r.count--;
+
+  return obj;
+}
+
+void ObjDeque::Clear() {
+  this->_ring = std::make_shared<Ring>();
+}
+
+std::string ObjDeque::ToString() const {
+  std::string ret = "deque[";
+
+  for (size_t i = 0; i < this->Count(); i++) {
+    if (i >= 1)
+      ret += ", ";
+
+    ret += this->At(i)->ToStringAsMember();
+  }
+
+  return ret + "]";
+}
+
+ObjPointer ObjDeque::Clone() const {
+  auto obj = ObjNew<ObjDeque>(this->type);
+
+  obj->_ring = this->_ring;
+
+  return obj;
+}
+
+bool ObjDeque::Equals(ObjPointer obj) const {
+  if (!obj->is_deque())
+    return false;
+
+  auto x = obj->As<ObjDeque>();
+
+  if (this->_ring == x->_ring)
+    return true;
+
+  if (this->Count() != x->Count())
+    return false;
+
+  for (size_t i = 0; i < this->Count(); i++)
+    if (!this->At(i)->Equals(x->At(i)))
+      return false;
+
+  return true;
+}
+
+ObjDeque::ObjDeque(TypeInfo type)
+    : Object(std::move(type)),
+      _ring(std::make_shared<Ring>()) {
+}
+
+// ----------------------------
+//  ObjPriorityQueue
+
+Vec<ObjPointer>& ObjPriorityQueue::GetMutable() {
+  if (this->_heap.use_count() >= 2) {
+    auto copy = std::make_shared<Vec<ObjPointer>>();
+
+    copy->reserve(this->_heap->size());
+
+    for (auto&& e : *this->_heap)
+      copy->emplace_back(ObjIterable::CopyElement(e));
+
+    this->_heap = std::move(copy);
+  }
+
+  return *this->_heap;
+}
+
+bool ObjPriorityQueue::Less(ObjPointer const& a, ObjPointer const& b) const {
+  auto const& x = this->_reverse ? b : a;
+  auto const& y = this->_reverse ? a : b;
+
+  switch (this->type.params[0].kind) {
+  case TypeKind::Int:
+    return x->get_vi() < y->get_vi();
+
+  case TypeKind::Float:
+    return x->get_vf() < y->get_vf();
+
+  case TypeKind::Char:
+    return x->get_vc() < y->get_vc();
+
+  case TypeKind::String:
+    return x->As<ObjString>()->View() < y->As<ObjString>()->View();
+  }
+
+  todo_impl;
+}
+
+void ObjPriorityQueue::SiftUp(Vec<ObjPointer>& h, size_t index) {
+  auto obj = std::move(h[index]);
+
+  while (index > 0) {
+    auto parent = (index - 1) / 2;
+
+    if (!this->Less(h[parent], obj))
+      break;
+
+    h[index] = std::move(h[parent]);
+    index = parent;
+  }
+
+  h[index] = std::move(obj);
+}
+
+void ObjPriorityQueue::Push(ObjPointer obj) {
+  auto& h = this->GetMutable();
+
+  h.emplace_back(std::move(obj));
+
+  this->SiftUp(h, h.size() - 1);
+}
+
+//
+// the hole at top is moved down to a leaf along larger children,
+// then last element is put there and sifted up.
+// (fewer comparisons than usual sift-down; the last element is likely small)
+//
+ObjPointer ObjPriorityQueue::Pop() {
+  auto& h = this->GetMutable();
+
+  auto top = std::move(h.front());
+  auto last = std::move(h.back());
+
+  h.pop_back();
+
+  if (h.empty())
+    return top;
+
+  size_t index = 0;
+
+  for (size_t child; (child = index * 2 + 1) < h.size(); index = child) {
+    if (child + 1 < h.size() && this->Less(h[child], h[child + 1]))
+      child++;
+
+    h[index] = std::move(h[child]);
+  }
+
+  h[index] = std::move(last);
+
+  this->SiftUp(h, index);
+
+  return top;
+}
+
+void ObjPriorityQueue::Clear() {
+  this->_heap = std::make_shared<Vec<ObjPointer>>();
+}
+
+void ObjPriorityQueue::SetReversed(bool reverse) {
+  if (this->_reverse == reverse)
+    return;
+
+  this->_reverse = reverse;
+
+  auto& h = this->GetMutable();
+
+  std::make_heap(h.begin(), h.end(),
+                 [this](ObjPointer const& a, ObjPointer const& b) { return this->Less(a, b); });
+}
+
+Vec<ObjPointer> ObjPriorityQueue::Sorted() const {
+  auto ret = *this->_heap;
+
+  std::sort(ret.begin(), ret.end(),
+            [this](ObjPointer const& a, ObjPointer const& b) { return this->Less(b, a); });
+
+  return ret;
+}
+
+std::string ObjPriorityQueue::ToString() const {
+  std::string ret = "priority_queue[";
+
+  for (auto&& e : this->Sorted()) {
+    if (ret.back() != '[')
+      ret += ", ";
+
+    ret += e->ToStringAsMember();
+  }
+
+  return ret + "]";
+}
+
+ObjPointer ObjPriorityQueue::Clone() const {
+  auto obj = ObjNew<ObjPriorityQueue>(this->type);
+
+  obj->_heap = this->_heap;
+  obj->_reverse = this->_reverse;
+
+  return obj;
+}
+
+bool ObjPriorityQueue::Equals(ObjPointer obj) const {
+  if (obj->type.kind != TypeKind::PriorityQueue)
+    return false;
+
+  auto x = obj->As<ObjPriorityQueue>();
+
+  if (this->Count() != x->Count() || this->_reverse != x->_reverse)
+    return false;
+
+  // same elements, regardless of layout of heap
+  auto a = this->Sorted();
+  auto b = x->Sorted();
+
+  for (size_t i = 0; i < a.size(); i++)
+    if (!a[i]->Equals(b[i]))
+      return false;
+
+  return true;
+}
+
+ObjPriorityQueue::ObjPriorityQueue(TypeInfo type)
+    : Object(std::move(type)),
+      _heap(std::make_shared<Vec<ObjPointer>>()) {
+}
+
+// ----------------------------
+//  ObjMatrix
+
+std::string ObjMatrix::ToString() const {
+  std::string ret = "matrix[";
+  ObjPrimitive e{0.0};
+
+  for (size_t i = 0; i < this->rows; i++) {
+    ret += i >= 1 ? ", [" : "[";
+
+    for (size_t j = 0; j < this->cols; j++) {
+      if (j >= 1)
+        ret += ", ";
+
+      e.vf = this->At(i, j);
+      e.AppendTo(ret);
+    }
+
+    ret += "]";
+  }
+
+  return ret + "]";
+}
+
+ObjPointer ObjMatrix::Clone() const {
+  auto obj = ObjNew<ObjMatrix>(0, 0);
+
+  obj->rows = this->rows;
+  obj->cols = this->cols;
+  obj->data = this->data;
+
+  return obj;
+}
+
+bool ObjMatrix::Equals(ObjPointer obj) const {
+  if (obj->type.kind != TypeKind::Matrix)
+    return false;
+
+  auto x = obj->As<ObjMatrix>();
+
+  return this->rows == x->rows && this->cols == x->cols && this->data == x->data;
+}
+
+ObjMatrix::ObjMatrix(size_t rows, size_t cols)
+    : Object(TypeKind::Matrix),
+      rows(rows),
+      cols(cols),
+      data(rows * cols) {
+}
+
+// ----------------------------
+//  ObjBytes
+
+ObjPtr<ObjBytes> ObjBytes::Slice(size_t pos, size_t length) const {
+  auto obj = ObjNew<ObjBytes>(this->_buf);
+
+  obj->_owner = this->_owner;
+  obj->_borrowed = this->_borrowed;
+  obj->_is_slice = true;
+  obj->_offset = this->_offset + pos;
+  obj->_length = std::min(length, this->Length() - pos);
+
+  return obj;
+}
+
+Vec<u8>& ObjBytes::GetMutable() {
+  if (this->_owner || this->_is_slice || this->_buf.use_count() > 1) {
+    auto view = this->View();
+
+    this->_buf = std::make_shared<Vec<u8>>(view.begin(), view.end());
+    this->_owner = nullptr;
+    this->_borrowed = {};
+    this->_is_slice = false;
+    this->_offset = 0;
+  }
+
+  return *this->_buf;
+}
+
+// bytes[01 ff 7f]
+std::string ObjBytes::ToString() const {
+  static constexpr char digits[] = "0123456789abcdef";
+
+  auto view = this->View();
+
+  std::string ret = "bytes[";
+
+  ret.reserve(view.size() * 3 + 7);
+
+  for (size_t i = 0; i < view.size(); i++) {
+    if (i >= 1)
+      ret += ' ';
+
+    ret += digits[view[i] >> 4];
+    ret += digits[view[i] & 15];
+  }
+
+  return ret + "]";
+}
+
+ObjPointer ObjBytes::Clone() const {
+  if (this->_is_slice && is_pinning_buffer(this->_length, this->Buffer().size())) {
+    auto view = this->View();
+
+    return ObjNew<ObjBytes>(Vec<u8>(view.begin(), view.end()));
+  }
+
+  auto obj = ObjNew<ObjBytes>(this->_buf);
+
+  obj->_owner = this->_owner;
+  obj->_borrowed = this->_borrowed;
+
+  obj->_is_slice = this->_is_slice;
+  obj->_offset = this->_offset;
+  obj->_length = this->_length;
+
+  return obj;
+}
+
+bool ObjBytes::Equals(ObjPointer obj) const {
+  if (!obj->is_bytes())
+    return false;
+
+  auto a = this->View();
+  auto b = obj->As<ObjBytes>()->View();
+
+  return a.size() == b.size() && (a.empty() || std::memcmp(a.data(), b.data(), a.size()) == 0);
+}
+
+ObjBytes::ObjBytes(Vec<u8>&& data)
+    : ObjBytes(std::make_shared<Vec<u8>>(std::move(data))) {
+}
+
+ObjBytes::ObjBytes(std::shared_ptr<Vec<u8>> buf)
+    : Object(TypeKind::Bytes),
+      _buf(std::move(buf)) {
+}
+
+ObjBytes::ObjBytes(std::shared_ptr<void const> owner, std::span<u8 const> view)
+    : Object(TypeKind::Bytes),
+      _buf(std::make_shared<Vec<u8>>()),
+      _owner(std::move(owner)),
+      _borrowed(view) {
+}
+
+// ----------------------------
+//  ObjLineReader
+
+ObjLineReader::ObjLineReader(std::shared_ptr<io::LineReader> reader)
+    : Object(TypeKind::LineReader),
+      reader(std::move(reader)) {
+}
+
 // ----------------------------
 //  ObjEnumerator
 
@@ -157,7 +1801,7 @@ std::string ObjEnumerator::ToString() const {
 
     for (size_t i = 0; i < e.types.size(); i++) {
       s += e.types[i]->As<AST::Argument>()->name.str + ": " +
-           this->data->As<ObjIterable>()->list[i]->ToStringAsMember() + ", ";
+           this->data->As<ObjIterable>()->GetList()[i]->ToStringAsMember() + ", ";
     }
 
     s.erase(s.length() - 1);
@@ -23,7 +23,7 @@ ASTPointer Parser::Stmt() {
     }
 
     while (this->check()) {
-      ast->list.emplace_back(this->Stmt());
+      this->append_stmt(ast->list, this->Stmt());
 
       if (this->eat("}")) {
         ast->endtok = *this->ate;
@@ -90,11 +90,13 @@ ASTPointer Parser::Stmt() {
   if (this->eat("for")) {
     ASTPointer init = nullptr, cond = nullptr, step = nullptr;
 
+    ASTVector init_list;
+
     if (this->match("let")) {
-      init = this->Stmt();
+      this->append_stmt(init_list, this->Stmt());
     }
     else if (!this->eat(";")) {
-      init = this->Expr();
+      init_list.emplace_back(this->Expr());
       this->expect(";");
     }
 
@@ -113,13 +115,14 @@ ASTPointer Parser::Stmt() {
     this->expect("{", true);
     auto block = ASTCast<AST::Block>(this->Stmt());
 
-    return AST::Block::New(tok,
-                           {init, AST::Statement::NewWhile(tok, cond,
-                                                           AST::Block::New(tok, {
-                                                                                    block,
-                                                                                    step,
+    init_list.emplace_back(AST::Statement::NewWhile(tok, cond,
+                                                    AST::Block::New(tok, {
+                                                                             block,
+                                                                             step,
+
+                                                                         })));
 
-                                                                                }))});
+    return AST::Block::New(tok, std::move(init_list));
   }
 
   if (this->eat("return")) {
@@ -161,6 +164,40 @@ ASTPointer Parser::Stmt() {
   }
 
   if (this->eat("let")) {
+    // destructuring:  let (a, b, ...) = expr;
+    if (this->eat("(")) {
+      vector<Token> names;
+
+      do {
+        names.emplace_back(*this->expectIdentifier());
+      } while (this->eat(","));
+
+      this->expect(")");
+      this->expect("=");
+
+      auto init = this->Expr();
+      this->expect(";");
+
+      Token tmp = tok;
+
+      tmp.kind = TokenKind::Identifier;
+      tmp.str = "$tuple" + std::to_string(this->_tuple_count++);
+
+      for (size_t i = 0; i < names.size(); i++) {
+        // "_" is ignored
+        if (names[i].str == "_")
+          continue;
+
+        auto ref = new_expr(ASTKind::IndexRef, names[i], AST::Identifier::New(tmp),
+                            AST::Value::New(names[i], ObjNew<ObjPrimitive>((i64)i)));
+
+        this->_following_stmts.emplace_back(
+            AST::VarDef::New(names[i], names[i], nullptr, ref));
+      }
+
+      return AST::VarDef::New(tok, tmp, nullptr, init);
+    }
+
     auto ast = AST::VarDef::New(tok, *this->expectIdentifier());
 
     if (this->eat(":"))
@@ -440,7 +477,7 @@ ASTPointer Parser::Top() {
     bool closed = false;
 
     do {
-      ast->list.emplace_back(this->Top());
+      this->append_stmt(ast->list, this->Top());
     } while (this->check() && !(closed = this->eat("}")));
 
     if (!closed)
@@ -490,7 +527,7 @@ ASTPtr<AST::Block> Parser::Parse() {
   }
 
   while (this->check()) {
-    ret->list.emplace_back(this->Top());
+    this->append_stmt(ret->list, this->Top());
   }
 
   for (size_t i = 0; i < this->tokens.size(); i++) {
@@ -7,6 +7,58 @@
 
 namespace fire::parser {
 
+//
+// content of char or string literal, escape sequences are replaced.
+//
+static string unescape_literal(Token const& tok) {
+  string ret;
+
+  auto const& s = tok.str;
+
+  for (size_t i = 1; i + 1 < s.length(); i++) {
+    if (s[i] != '\\') {
+      ret += s[i];
+      continue;
+    }
+
+    switch (s[++i]) {
+    case 'n':
+      ret += '\n';
+      break;
+
+    case 'r':
+      ret += '\r';
+      break;
+
+    case 't':
+      ret += '\t';
+      break;
+
+    case '0':
+      ret += '\0';
+      break;
+
+    case '\\':
+    case '\'':
+    case '"':
+      ret += s[i];
+      break;
+
+    default: {
+      auto e = tok;
+
+      e.sourceloc.position += i - 1;
+      e.sourceloc.pos_in_line += i - 1;
+      e.sourceloc.length = 2;
+
+      throw Error(e, "invalid escape sequence");
+    }
+    }
+  }
+
+  return ret;
+}
+
 static ObjPtr<ObjPrimitive> make_value_from_token(Token const& tok) {
   auto k = tok.kind;
   auto const& s = tok.str;
@@ -27,7 +79,7 @@ static ObjPtr<ObjPrimitive> make_value_from_token(Token const& tok) {
   }
 
   case TokenKind::Char: {
-    auto s16 = utils::to_u16string(string(s.substr(1, s.length() - 2)));
+    auto s16 = utils::to_u16string(unescape_literal(tok));
 
     if (s16.length() != 1)
       throw Error(tok, "the length of character literal is must 1.");
@@ -55,7 +107,28 @@ static ObjPtr<ObjPrimitive> make_value_from_token(Token const& tok) {
 ASTPointer Parser::Factor() {
 
   if (this->eat("(")) {
+    auto tok = *this->ate;
     auto x = this->Expr();
+
+    // tuple:  (a, b, ...)  (a,)
+    if (this->eat(",")) {
+      auto tuple = AST::Array::New(tok);
+
+      tuple->kind = ASTKind::Tuple;
+      tuple->elements.emplace_back(x);
+
+      while (!this->eat(")")) {
+        tuple->elements.emplace_back(this->Expr());
+
+        if (!this->eat(",")) {
+          this->expect(")");
+          break;
+        }
+      }
+
+      return tuple;
+    }
+
     this->expect(")");
     return x;
   }
@@ -74,37 +147,26 @@ ASTPointer Parser::Factor() {
     return x;
   }
 
-  auto& tok = *this->cur++;
-
-  if (tok.kind == TokenKind::Char || tok.kind == TokenKind::String) {
-    auto it = tok.str.begin();
-    auto end = tok.str.end();
-
-    while (it != end) {
-      if (*it == '\\') {
-        size_t index = tok.sourceloc.position + (it - tok.str.begin());
-
-        switch (it[1]) {
-        case 'n':
-          tok.get_src_data().replace(index, index + 2, "\n");
-          break;
-
-        case 'r':
-          tok.get_src_data().replace(index, index + 2, "\r");
-          break;
+  // dict
+  if (this->eat("{")) {
+    auto x = AST::Dict::New(*this->ate);
 
-        default:
-          tok.sourceloc.position += (end - it);
-          tok.sourceloc.length = 1;
+    while (!this->eat("}")) {
+      x->keys.emplace_back(this->Expr());
+      this->expect(":");
+      x->values.emplace_back(this->Expr());
 
-          throw Error(tok, "invalid escape sequence");
-        }
+      if (!this->eat(",")) {
+        this->expect("}");
+        break;
       }
-
-      it++;
     }
+
+    return x;
   }
 
+  auto& tok = *this->cur++;
+
   switch (tok.kind) {
   case TokenKind::Int:
   case TokenKind::Float:
@@ -114,8 +176,8 @@ ASTPointer Parser::Factor() {
     return AST::Value::New(tok, make_value_from_token(tok));
 
   case TokenKind::String: {
-    auto xx = AST::Value::New(
-        tok, ObjNew<ObjString>(string(tok.str.substr(1, tok.str.length() - 2))));
+    auto xx =
+        AST::Value::New(tok, ObjString::Intern(utils::to_u16string(unescape_literal(tok))));
 
     return xx;
   }
@@ -227,6 +289,24 @@ ASTPointer Parser::Lambda() {
   return this->ScopeResol();
 }
 
+ASTPtr<AST::CallFunc> Parser::new_slice(Token& op, ASTPointer obj, ASTPointer begin,
+                                        ASTPointer end) {
+  Token name = op;
+
+  name.kind = TokenKind::Identifier;
+  name.str = "slice";
+
+  auto call = AST::CallFunc::New(
+      new_expr(ASTKind::MemberAccess, op, obj, AST::Identifier::New(name)));
+
+  call->args.emplace_back(begin);
+
+  if (end)
+    call->args.emplace_back(end);
+
+  return call;
+}
+
 ASTPointer Parser::IndexRef() {
   auto x = this->Lambda();
 
@@ -235,7 +315,37 @@ ASTPointer Parser::IndexRef() {
 
     // index reference
     if (this->eat("[")) {
-      x = new_expr(ASTKind::IndexRef, op, x, this->Expr());
+      //
+      // range index:  x[begin..end]  x[begin..]  x[..end]
+      //   replaced to x.slice(begin, end) or x.slice(begin)
+      //
+      if (this->eat("..")) {
+        x = this->new_slice(op, x, AST::Value::New(op, ObjNew<ObjPrimitive>((i64)0)),
+                            this->Expr());
+      }
+      else if (auto index = this->Expr(); this->eat("..")) {
+        x = this->new_slice(op, x, index, this->match("]") ? nullptr : this->Expr());
+      }
+      //
+      // multiple indices:  m[i, j]
+      //   given as a tuple.
+      //
+      else if (this->eat(",")) {
+        auto tuple = AST::Array::New(op);
+
+        tuple->kind = ASTKind::Tuple;
+        tuple->elements.emplace_back(index);
+
+        do {
+          tuple->elements.emplace_back(this->Expr());
+        } while (this->eat(","));
+
+        x = new_expr(ASTKind::IndexRef, op, x, tuple);
+      }
+      else {
+        x = new_expr(ASTKind::IndexRef, op, x, index);
+      }
+
       this->expect("]");
     }
 
@@ -0,0 +1,113 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include "Random.h"
+#include "Kernels.h"
+
+namespace fire::rng {
+
+void Xoshiro256::Seed(u64 seed) {
+  // splitmix64
+  for (auto& x : this->s) {
+    u64 z = (seed += 0x9e3779b97f4a7c15);
+
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+
+    x = z ^ (z >> 31);
+  }
+
+  this->has_spare = false;
+}
+
+u64 Xoshiro256::Bounded(u64 n) {
+  auto m = (unsigned __int128)this->Next() * n;
+
+  if ((u64)m < n) {
+    u64 threshold = -n % n;
+
+    while ((u64)m < threshold)
+      m = (unsigned __int128)this->Next() * n;
+  }
+
+  return (u64)(m >> 64);
+}
+
+// polar method; makes two values at once.
+double Xoshiro256::Normal() {
+  if (this->has_spare) {
+    this->has_spare = false;
+    return this->spare;
+  }
+
+  double u, v, s;
+
+  do {
+    u = this->NextDouble() * 2 - 1;
+    v = this->NextDouble() * 2 - 1;
+    s = u * u + v * v;
+  } while (s >= 1 || s == 0);
+
+  s = std::sqrt(-2 * std::log(s) / s);
+
+  this->spare = v * s;
+  this->has_spare = true;
+
+  return u * s;
+}
+
+void Xoshiro256::FillUniform(double* out, size_t n, double lo, double hi) {
+  double w = hi - lo;
+
+  for (size_t i = 0; i < n; i++)
+    out[i] = lo + this->NextDouble() * w;
+}
+
+void Xoshiro256::FillUniform(i64* out, size_t n, i64 lo, u64 range) {
+  for (size_t i = 0; i < n; i++)
+    out[i] = (i64)((u64)lo + this->Bounded(range));
+}
+
+//
+// Box-Muller transform, by blocks.
+//   r = sqrt(-2 log u1),  t = 2 pi u2
+//   --> r cos t, r sin t
+//
+//  log, sin and cos are computed by vectorized kernels. (see Kernels.h)
+//
+void Xoshiro256::FillNormal(double* out, size_t n, double mean, double stddev) {
+  constexpr size_t block = 256;
+
+  double u1[block], u2[block], c[block];
+
+  for (size_t i = 0; i < n; i += block * 2) {
+    size_t m = std::min(block, (n - i + 1) / 2);
+
+    for (size_t j = 0; j < m; j++) {
+      u1[j] = 1.0 - this->NextDouble(); // (0, 1]
+      u2[j] = this->NextDouble() * (2 * M_PI);
+    }
+
+    kernels::Log(u1, u1, m);
+    kernels::Cos(u2, c, m);
+    kernels::Sin(u2, u2, m);
+
+    for (size_t j = 0; j < m; j++) {
+      double r = std::sqrt(-2 * u1[j]) * stddev;
+
+      out[i + j * 2] = mean + r * c[j];
+
+      if (i + j * 2 + 1 < n)
+        out[i + j * 2 + 1] = mean + r * u2[j];
+    }
+  }
+}
+
+Xoshiro256& Get() {
+  static Xoshiro256 gen{((u64)std::random_device{}() << 32) ^ std::random_device{}()};
+
+  return gen;
+}
+
+} // namespace fire::rng
@@ -0,0 +1,784 @@
+#include <algorithm>
+#include <list>
+#include <unordered_map>
+
+#include "alert.h"
+#include "Regex.h"
+
+namespace fire::regex {
+
+// limit of DFA states per regex. if exceeded, all states are dropped.
+static constexpr size_t max_dfa_states = 4096;
+
+// limit of {m,n}
+static constexpr int max_repeat = 1000;
+
+static constexpr size_t cache_capacity = 64;
+
+using Ranges = Vec<std::pair<char16_t, char16_t>>;
+
+// ----------------------------
+//  Compiler
+//
+//  pattern --> syntax tree --> program (Thompson NFA)
+
+struct Node {
+  enum Kind {
+    Empty,
+    Set,
+    Concat,
+    Alter,
+    Repeat,
+    Begin,
+    End,
+  };
+
+  Kind kind;
+
+  int set = -1;
+
+  Vec<Node> children;
+
+  // Repeat: max = -1 is infinity
+  int min = 0;
+  int max = 0;
+
+  Node(Kind kind = Empty)
+      : kind(kind) {
+  }
+};
+
+class Compiler {
+  std::u16string_view src;
+  size_t pos = 0;
+
+  Regex& re;
+
+  [[noreturn]] void error(string const& msg) {
+    throw PatternError{msg, this->pos};
+  }
+
+  bool check() const {
+    return this->pos < this->src.length();
+  }
+
+  char16_t peek() const {
+    return this->src[this->pos];
+  }
+
+  bool eat(char16_t c) {
+    if (this->check() && this->peek() == c) {
+      this->pos++;
+      return true;
+    }
+
+    return false;
+  }
+
+  int add_set(Ranges ranges, bool negate) {
+    std::sort(ranges.begin(), ranges.end());
+
+    // merge overlapped
+    Ranges merged;
+
+    for (auto&& r : ranges) {
+      if (!merged.empty() && r.first <= merged.back().second + 1)
+        merged.back().second = std::max(merged.back().second, r.second);
+      else
+        merged.emplace_back(r);
+    }
+
+    if (negate) {
+      Ranges inv;
+      u32 begin = 0;
+
+      for (auto&& [lo, hi] : merged) {
+        if (begin < lo)
+          inv.emplace_back(begin, lo - 1);
+
+        begin = hi + 1u;
+      }
+
+      if (begin <= 0xFFFF)
+        inv.emplace_back(begin, 0xFFFF);
+
+      merged = std::move(inv);
+    }
+
+    this->re.sets.emplace_back(std::move(merged));
+
+    return (int)this->re.sets.size() - 1;
+  }
+
+  //
+  // \d \w \s
+  static bool get_class_escape(char16_t c, Ranges& out, bool& negate) {
+    negate = 'A' <= c && c <= 'Z';
+
+    switch (c) {
+    case 'd':
+    case 'D':
+      out.emplace_back('0', '9');
+      return true;
+
+    case 'w':
+    case 'W':
+      out.emplace_back('0', '9');
+      out.emplace_back('A', 'Z');
+      out.emplace_back('_', '_');
+      out.emplace_back('a', 'z');
+      return true;
+
+    case 's':
+    case 'S':
+      out.emplace_back('\t', '\r');
+      out.emplace_back(' ', ' ');
+      return true;
+    }
+
+    return false;
+  }
+
+  char16_t escaped_char() {
+    if (!this->check())
+      this->error("pattern ends with '\\'");
+
+    switch (char16_t c = this->src[this->pos++]) {
+    case 'n':
+      return '\n';
+    case 't':
+      return '\t';
+    case 'r':
+      return '\r';
+    case 'f':
+      return '\f';
+    case 'v':
+      return '\v';
+    case '0':
+      return '\0';
+
+    default:
+      if (('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z') || ('0' <= c && c <= '9')) {
+        this->pos--;
+        this->error("unknown escape sequence");
+      }
+
+      return c;
+    }
+  }
+
+  Node make_set(Ranges ranges, bool negate = false) {
+    Node node{Node::Set};
+
+    node.set = this->add_set(std::move(ranges), negate);
+
+    return node;
+  }
+
+  // [...]
+  Node bracket() {
+    bool negate = this->eat('^');
+
+    Ranges ranges;
+
+    for (bool first = true;; first = false) {
+      if (!this->check())
+        this->error("missing ']'");
+
+      if (this->peek() == ']' && !first)
+        break;
+
+      char16_t lo = this->src[this->pos++];
+
+      if (lo == '\\') {
+        Ranges cls;
+        bool neg;
+
+        if (this->check() && get_class_escape(this->peek(), cls, neg)) {
+          this->pos++;
+
+          if (neg) {
+            // negated class in bracket: add complement
+            auto const& set = this->re.sets[this->add_set(cls, true)];
+            ranges.insert(ranges.end(), set.begin(), set.end());
+            this->re.sets.pop_back();
+          }
+          else
+            ranges.insert(ranges.end(), cls.begin(), cls.end());
+
+          continue;
+        }
+
+        lo = this->escaped_char();
+      }
+
+      char16_t hi = lo;
+
+      if (this->pos + 1 < this->src.length() && this->peek() == '-' &&
+          this->src[this->pos + 1] != ']') {
+        this->pos++;
+
+        hi = this->src[this->pos++];
+
+        if (hi == '\\')
+          hi = this->escaped_char();
+
+        if (hi < lo)
+          this->error("invalid range in brackets");
+      }
+
+      ranges.emplace_back(lo, hi);
+    }
+
+    this->pos++; // ']'
+
+    return this->make_set(std::move(ranges), negate);
+  }
+
+  Node atom() {
+    switch (char16_t c = this->src[this->pos++]) {
+    case '(': {
+      // (?:...) is same as (...), groups are not captured.
+      if (this->eat('?') && !this->eat(':'))
+        this->error("unsupported group");
+
+      auto node = this->alternation();
+
+      if (!this->eat(')'))
+        this->error("missing ')'");
+
+      return node;
+    }
+
+    case '[':
+      return this->bracket();
+
+    case '.':
+      // except newline
+      return this->make_set({{'\n', '\n'}}, true);
+
+    case '^':
+      return Node{Node::Begin};
+
+    case '$':
+      return Node{Node::End};
+
+    case '\\': {
+      Ranges cls;
+      bool neg;
+
+      if (this->check() && get_class_escape(this->peek(), cls, neg)) {
+        this->pos++;
+        return this->make_set(std::move(cls), neg);
+      }
+
+      c = this->escaped_char();
+      return this->make_set({{c, c}});
+    }
+
+    case '*':
+    case '+':
+    case '?':
+    case '{':
+      this->pos--;
+      this->error("nothing to repeat");
+
+    default:
+      return this->make_set({{c, c}});
+    }
+  }
+
+  int number() {
+    int n = 0;
+
+    if (!this->check() || !('0' <= this->peek() && this->peek() <= '9'))
+      this->error("expected number");
+
+    while (this->check() && '0' <= this->peek() && this->peek() <= '9') {
+      n = n * 10 + (this->src[this->pos++] - '0');
+
+      if (n > max_repeat)
+        this->error("too large repeat count");
+    }
+
+    return n;
+  }
+
+  Node repeat() {
+    auto node = this->atom();
+
+    while (this->check()) {
+      int min, max;
+
+      if (this->eat('*'))
+        min = 0, max = -1;
+      else if (this->eat('+'))
+        min = 1, max = -1;
+      else if (this->eat('?'))
+        min = 0, max = 1;
+      else if (this->eat('{')) {
+        min = max = this->number();
+
+        if (this->eat(','))
+          max = this->check() && this->peek() == '}' ? -1 : this->number();
+
+        if (!this->eat('}'))
+          this->error("missing '}'");
+
+        if (max != -1 && max < min)
+          this->error("invalid repeat range");
+      }
+      else
+        break;
+
+      if (this->check() && this->peek() == '?')
+        this->error("lazy quantifier is not supported");
+
+      Node rep{Node::Repeat};
+
+      rep.min = min;
+      rep.max = max;
+      rep.children.emplace_back(std::move(node));
+
+      node = std::move(rep);
+    }
+
+    return node;
+  }
+
+  Node concat() {
+    Node node{Node::Concat};
+
+    while (this->check() && this->peek() != '|' && this->peek() != ')')
+      node.children.emplace_back(this->repeat());
+
+    return node;
+  }
+
+  Node alternation() {
+    auto node = this->concat();
+
+    if (this->check() && this->peek() == '|') {
+      Node alt{Node::Alter};
+
+      alt.children.emplace_back(std::move(node));
+
+      while (this->eat('|'))
+        alt.children.emplace_back(this->concat());
+
+      return alt;
+    }
+
+    return node;
+  }
+
+  //
+  // code generation
+  //
+
+  using Inst = Regex::Inst;
+
+  Vec<Inst>& code() {
+    return this->re.program;
+  }
+
+  int emit(Inst::Op op, int next = -1, int arg = -1) {
+    this->code().emplace_back(Inst{op, next, arg});
+
+    return (int)this->code().size() - 1;
+  }
+
+  int here() {
+    return (int)this->code().size();
+  }
+
+  void gen(Node const& node) {
+    switch (node.kind) {
+    case Node::Empty:
+      break;
+
+    case Node::Set:
+      this->emit(Inst::Char, this->here() + 1, node.set);
+      break;
+
+    case Node::Begin:
+      this->emit(Inst::AssertBegin, this->here() + 1);
+      break;
+
+    case Node::End:
+      this->emit(Inst::AssertEnd, this->here() + 1);
+      break;
+
+    case Node::Concat:
+      for (auto&& c : node.children)
+        this->gen(c);
+      break;
+
+    case Node::Alter: {
+      //     split L1, L2
+      // L1: a
+      //     jump END
+      // L2: split L3, L4
+      // ...
+      Vec<int> jumps;
+
+      for (size_t i = 0; i < node.children.size(); i++) {
+        if (i + 1 == node.children.size()) {
+          this->gen(node.children[i]);
+          break;
+        }
+
+        auto split = this->emit(Inst::Split, this->here() + 1);
+
+        this->gen(node.children[i]);
+
+        jumps.emplace_back(this->emit(Inst::Jump));
+
+        this->code()[split].arg = this->here();
+      }
+
+      for (auto j : jumps)
+        this->code()[j].next = this->here();
+
+      break;
+    }
+
+    case Node::Repeat: {
+      auto const& x = node.children[0];
+
+      for (int i = 0; i < node.min; i++)
+        this->gen(x);
+
+      if (node.max == -1) {
+        // L1: split L2, END
+        // L2: x
+        //     jump L1
+        auto split = this->emit(Inst::Split, this->here() + 1);
+
+        this->gen(x);
+        this->emit(Inst::Jump, split);
+
+        this->code()[split].arg = this->here();
+      }
+      else {
+        Vec<int> splits;
+
+        for (int i = node.min; i < node.max; i++) {
+          splits.emplace_back(this->emit(Inst::Split, this->here() + 1));
+          this->gen(x);
+        }
+
+        for (auto s : splits)
+          this->code()[s].arg = this->here();
+      }
+
+      break;
+    }
+    }
+
+    if (this->code().size() > 100000)
+      this->error("pattern is too large");
+  }
+
+public:
+  Compiler(std::u16string_view src, Regex& re)
+      : src(src),
+        re(re) {
+  }
+
+  void compile() {
+    auto node = this->alternation();
+
+    if (this->check()) // unmatched ')'
+      this->error("unexpected ')'");
+
+    this->gen(node);
+    this->emit(Inst::Accept);
+  }
+};
+
+// ----------------------------
+//  Regex
+
+Regex::Regex(std::u16string_view pattern)
+    : pattern(pattern) {
+  this->anchored.unanchored = false;
+  this->unanchored.unanchored = true;
+}
+
+std::shared_ptr<Regex> Regex::Compile(std::u16string_view pattern) {
+  auto re = std::make_shared<Regex>(pattern);
+
+  Compiler(pattern, *re).compile();
+
+  re->make_classes();
+
+  return re;
+}
+
+void Regex::make_classes() {
+  for (auto&& set : this->sets) {
+    for (auto&& [lo, hi] : set) {
+      this->class_bounds.emplace_back(lo);
+
+      if (hi < 0xFFFF)
+        this->class_bounds.emplace_back(hi + 1);
+    }
+  }
+
+  auto& b = this->class_bounds;
+
+  std::sort(b.begin(), b.end());
+  b.erase(std::unique(b.begin(), b.end()), b.end());
+
+  for (int c = 0; c < 128; c++)
+    this->ascii_class[c] = std::upper_bound(b.begin(), b.end(), c) - b.begin();
+
+  //
+  // a class is never divided by a range, so check with the first unit.
+  size_t class_count = b.size() + 1;
+
+  for (auto&& set : this->sets) {
+    auto& has = this->set_has_class.emplace_back(class_count, false);
+
+    for (size_t k = 0; k < class_count; k++) {
+      char16_t c = k == 0 ? 0 : b[k - 1];
+
+      for (auto&& [lo, hi] : set) {
+        if (lo <= c && c <= hi) {
+          has[k] = true;
+          break;
+        }
+      }
+    }
+  }
+}
+
+int Regex::class_of(char16_t c) const {
+  if (c < 128)
+    return this->ascii_class[c];
+
+  auto const& b = this->class_bounds;
+
+  return std::upper_bound(b.begin(), b.end(), c) - b.begin();
+}
+
+void Regex::add_closure(Vec<int>& out, Vec<bool>& visited, int pc, bool at_begin,
+                        bool at_end) const {
+  if (visited[pc])
+    return;
+
+  visited[pc] = true;
+
+  auto const& inst = this->program[pc];
+
+  switch (inst.op) {
+  case Inst::Split:
+    this->add_closure(out, visited, inst.next, at_begin, at_end);
+    this->add_closure(out, visited, inst.arg, at_begin, at_end);
+    break;
+
+  case Inst::Jump:
+    this->add_closure(out, visited, inst.next, at_begin, at_end);
+    break;
+
+  case Inst::AssertBegin:
+    if (at_begin)
+      this->add_closure(out, visited, inst.next, at_begin, at_end);
+    break;
+
+  case Inst::AssertEnd:
+    if (at_end)
+      this->add_closure(out, visited, inst.next, at_begin, at_end);
+    else
+      out.emplace_back(pc);
+    break;
+
+  default:
+    out.emplace_back(pc);
+    break;
+  }
+}
+
+int Regex::get_state(DFA& dfa, Vec<int>&& insts) {
+  std::sort(insts.begin(), insts.end());
+
+  if (auto it = dfa.state_map.find(insts); it != dfa.state_map.end())
+    return it->second;
+
+  // too many states: drop all, and construct again from here.
+  if (dfa.states.size() >= max_dfa_states) {
+    dfa.states.clear();
+    dfa.state_map.clear();
+    dfa.generation++;
+    dfa.start[0] = dfa.start[1] = -1;
+  }
+
+  DFAState state;
+
+  Vec<int> at_end;
+  Vec<bool> visited(this->program.size());
+
+  for (auto pc : insts) {
+    switch (this->program[pc].op) {
+    case Inst::Accept:
+      state.accept = true;
+      break;
+
+    case Inst::AssertEnd:
+      this->add_closure(at_end, visited, pc, false, true);
+      break;
+    }
+  }
+
+  state.accept_at_end =
+      state.accept || std::any_of(at_end.begin(), at_end.end(), [this](int pc) {
+        return this->program[pc].op == Inst::Accept;
+      });
+
+  state.next.resize(this->class_bounds.size() + 1, -1);
+  state.insts = insts;
+
+  int index = (int)dfa.states.size();
+
+  dfa.states.emplace_back(std::move(state));
+  dfa.state_map.emplace(std::move(insts), index);
+
+  return index;
+}
+
+int Regex::get_start(DFA& dfa, bool at_begin) {
+  if (auto s = dfa.start[at_begin]; s != -1)
+    return s;
+
+  Vec<int> insts;
+  Vec<bool> visited(this->program.size());
+
+  this->add_closure(insts, visited, 0, at_begin, false);
+
+  auto s = this->get_state(dfa, std::move(insts));
+
+  return dfa.start[at_begin] = s;
+}
+
+int Regex::step(DFA& dfa, int state, int cls) {
+  if (auto n = dfa.states[state].next[cls]; n != -1)
+    return n;
+
+  Vec<int> insts;
+  Vec<bool> visited(this->program.size());
+
+  for (auto pc : dfa.states[state].insts) {
+    auto const& inst = this->program[pc];
+
+    if (inst.op == Inst::Char && this->set_has_class[inst.arg][cls])
+      this->add_closure(insts, visited, inst.next, false, false);
+  }
+
+  // match can start at every position.
+  if (dfa.unanchored)
+    this->add_closure(insts, visited, 0, false, false);
+
+  auto gen = dfa.generation;
+  auto n = this->get_state(dfa, std::move(insts));
+
+  // if states were dropped, "state" is no longer valid.
+  if (gen == dfa.generation)
+    dfa.states[state].next[cls] = n;
+
+  return n;
+}
+
+bool Regex::Match(std::u16string_view str) {
+  auto& dfa = this->anchored;
+
+  int s = this->get_start(dfa, true);
+
+  for (char16_t c : str) {
+    s = this->step(dfa, s, this->class_of(c));
+
+    if (dfa.states[s].insts.empty())
+      return false;
+  }
+
+  return dfa.states[s].accept_at_end;
+}
+
+bool Regex::Search(std::u16string_view str, size_t from, size_t& begin, size_t& end) {
+  size_t const len = str.length();
+
+  //
+  // check that any match exists, by unanchored DFA.
+  {
+    auto& dfa = this->unanchored;
+
+    int s = this->get_start(dfa, from == 0);
+    bool found = dfa.states[s].accept;
+
+    for (size_t i = from; !found && i < len; i++) {
+      s = this->step(dfa, s, this->class_of(str[i]));
+      found = dfa.states[s].accept;
+    }
+
+    if (!found && !dfa.states[s].accept_at_end)
+      return false;
+  }
+
+  //
+  // find leftmost-longest.
+  auto& dfa = this->anchored;
+
+  for (size_t b = from; b <= len; b++) {
+    int s = this->get_start(dfa, b == 0);
+    size_t last = std::u16string_view::npos;
+
+    for (size_t i = b;; i++) {
+      auto const& st = dfa.states[s];
+
+      if (i == len ? st.accept_at_end : st.accept)
+        last = i;
+
+      if (i == len || st.insts.empty())
+        break;
+
+      s = this->step(dfa, s, this->class_of(str[i]));
+    }
+
+    if (last != std::u16string_view::npos) {
+      begin = b;
+      end = last;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// ----------------------------
+//  cache
+
+std::shared_ptr<Regex> get_compiled(std::u16string_view pattern) {
+  using Entry = std::shared_ptr<Regex>;
+
+  static std::list<Entry> lru; // front = most recently used
+  static std::unordered_map<std::u16string_view, std::list<Entry>::iterator> map;
+
+  if (auto it = map.find(pattern); it != map.end()) {
+    lru.splice(lru.begin(), lru, it->second);
+    return *it->second;
+  }
+
+  auto re = Regex::Compile(pattern);
+
+  if (lru.size() >= cache_capacity) {
+    map.erase(lru.back()->GetPattern());
+    lru.pop_back();
+  }
+
+  lru.emplace_front(re);
+  map.emplace(re->GetPattern(), lru.begin());
+
+  return re;
+}
+
+} // namespace fire::regex
@@ -68,6 +68,48 @@ TypeInfo Sema::eval_type(ASTPointer ast, SemaContext Ctx) {
     return type;
   }
 
+  case Kind::Tuple: {
+    auto x = ast->As<AST::Array>();
+    TypeInfo type = TypeKind::Tuple;
+
+    for (auto&& e : x->elements)
+      type.params.emplace_back(this->eval_type(e));
+
+    return x->elem_type = type;
+  }
+
+  case Kind::Dict: {
+    auto x = ast->As<AST::Dict>();
+
+    if (x->keys.empty()) {
+      if (Ctx.TypeExpection && Ctx.TypeExpection->Expected->kind == TypeKind::Dict) {
+        return x->type = *Ctx.TypeExpection->Expected;
+      }
+
+      throw Error(x->token, "cannot deduction type of empty dict")
+          .AddNote("specify type of variable. (like \"let d: dict<string, int> = {};\")");
+    }
+
+    TypeInfo type = {TypeKind::Dict,
+                     {this->eval_type(x->keys[0]), this->eval_type(x->values[0])}};
+
+    if (!ObjDict::IsHashableType(type.params[0]))
+      throw Error(x->keys[0], "'" + type.params[0].to_string() +
+                                  "' type cannot be used as key of dict");
+
+    for (size_t i = 1; i < x->keys.size(); i++) {
+      if (!type.params[0].equals(this->eval_type(x->keys[i])))
+        throw Error(x->keys[i], "expected '" + type.params[0].to_string() +
+                                    "' type expression as key in dict");
+
+      if (!type.params[1].equals(this->eval_type(x->values[i])))
+        throw Error(x->values[i], "expected '" + type.params[1].to_string() +
+                                      "' type expression as value in dict");
+    }
+
+    return x->type = type;
+  }
+
   case Kind::OverloadResolutionGuide: {
     auto x = ASTCast<AST::Expr>(ast);
 
@@ -136,6 +178,14 @@ TypeInfo Sema::eval_type(ASTPointer ast, SemaContext Ctx) {
 
     ASTPointer functor = call->callee;
 
+    //
+    // builtin method which is already decided.
+    //   (self is inserted to args[0])
+    if (call->callee_builtin && functor->kind == ASTKind::BuiltinMemberFunction) {
+      return this->make_functor_type(call->callee_builtin, this->eval_type(call->args[0]))
+          .params[0];
+    }
+
     ASTPtr<AST::Identifier> id = nullptr; // -> functor (if id or scoperesol)
 
     TypeVec arg_types;
@@ -180,21 +230,58 @@ TypeInfo Sema::eval_type(ASTPointer ast, SemaContext Ctx) {
     case ASTKind::BuiltinMemberFunction:
     case ASTKind::BuiltinFuncName: {
 
+      bool is_method = functor->kind == ASTKind::BuiltinMemberFunction;
+
+      // params[1] of method functor type is self.
+      auto self_type = is_method ? functor_type.params[1] : TypeInfo{};
+
+      ArgumentCheckResult res = ArgumentCheckResult::None;
+
       for (builtins::Function const* fn : id->candidates_builtin) {
-        auto res = this->check_function_call_parameters(call->args, fn->is_variable_args,
-                                                        fn->arg_types, arg_types, false);
+        auto fn_type = is_method ? this->make_functor_type(fn, self_type)
+                                 : this->make_functor_type(fn);
+
+        TypeVec formal = fn_type.params;
+
+        formal.erase(formal.begin(), formal.begin() + (is_method ? 2 : 1));
+
+        res = this->check_function_call_parameters(call->args, fn->is_variable_args,
+                                                   formal, arg_types, false);
 
         if (res.result == ArgumentCheckResult::Ok) {
           call->callee_builtin = fn;
 
-          if (functor->kind == ASTKind::BuiltinMemberFunction)
+          if (fn->prepare)
+            fn->prepare(call, arg_types);
+
+          if (is_method)
             call->args.insert(call->args.begin(), functor->as_expr()->lhs);
 
-          return fn->result_type;
+          return fn_type.params[0];
         }
       }
 
-      break;
+      if (id->candidates_builtin.size() == 1) {
+        auto fn_type = is_method ? this->make_functor_type(id->candidates_builtin[0], self_type)
+                                 : this->make_functor_type(id->candidates_builtin[0]);
+
+        switch (res.result) {
+        case ArgumentCheckResult::TooFewArguments:
+          throw Error(call->token, "too few arguments");
+
+        case ArgumentCheckResult::TooManyArguments:
+          throw Error(call->token, "too many arguments");
+
+        case ArgumentCheckResult::TypeMismatch:
+          throw Error(call->args[res.index],
+                      "expected '" +
+                          fn_type.params[res.index + (is_method ? 2 : 1)].to_string() +
+                          "' type expression, but found '" +
+                          arg_types[res.index].to_string() + "'");
+        }
+      }
+
+      throw Error(call->token, "no match function call '" + id->GetName() + "'");
     }
 
       //
@@ -320,7 +407,46 @@ TypeInfo Sema::eval_type(ASTPointer ast, SemaContext Ctx) {
 
     switch (arr.kind) {
     case TypeKind::Vector:
+    case TypeKind::Deque:
+      this->ExpectType(TypeKind::Int, x->rhs);
       return arr.params[0];
+
+    case TypeKind::String:
+      this->ExpectType(TypeKind::Int, x->rhs);
+      return TypeKind::Char;
+
+    case TypeKind::Bytes:
+      this->ExpectType(TypeKind::Int, x->rhs);
+      return TypeKind::U8;
+
+    case TypeKind::Dict:
+    case TypeKind::OrderedMap:
+      this->ExpectType(arr.params[0], x->rhs);
+      return arr.params[1];
+
+    case TypeKind::Tuple: {
+      // element type is decided by index; it must be a constant.
+      if (!x->rhs->Is(ASTKind::Value) || !x->rhs->as_value()->value->is_int())
+        throw Error(x->rhs, "index of tuple must be an integer literal");
+
+      auto index = x->rhs->as_value()->value->get_vi();
+
+      if (index < 0 || (size_t)index >= arr.params.size())
+        throw Error(x->rhs, "index " + std::to_string(index) + " is out of range of '" +
+                                arr.to_string() + "'");
+
+      return arr.params[index];
+    }
+
+    case TypeKind::Matrix: {
+      if (!x->rhs->Is(ASTKind::Tuple) || x->rhs->As<AST::Array>()->elements.size() != 2)
+        throw Error(x->rhs, "matrix must be indexed by row and column: m[i, j]");
+
+      for (auto&& e : x->rhs->As<AST::Array>()->elements)
+        this->ExpectType(TypeKind::Int, e);
+
+      return TypeKind::Float;
+    }
     }
 
     throw Error(x->op, "'" + arr.to_string() + "' type is not subscriptable");
@@ -368,10 +494,17 @@ TypeInfo Sema::eval_type(ASTPointer ast, SemaContext Ctx) {
   }
 
   case Kind::BuiltinMemberVariable:
-    todo_impl;
+    return ast->GetID()->blt_member_var->result_type;
 
-  case Kind::BuiltinMemberFunction:
-    todo_impl;
+  case Kind::BuiltinMemberFunction: {
+    auto id = ast->GetID();
+
+    if (id->candidates_builtin.size() >= 2)
+      throw Error(id->token, "function name '" + id->GetName() + "' is ambigous.");
+
+    return this->make_functor_type(id->candidates_builtin[0],
+                                   this->eval_type(ast->as_expr()->lhs));
+  }
 
   case Kind::Not: {
     auto x = ASTCast<AST::Expr>(ast);
@@ -394,7 +527,7 @@ TypeInfo Sema::eval_type(ASTPointer ast, SemaContext Ctx) {
         .E = x,
         .Left = x->lhs,
         .Right = x->rhs,
-        .LeftID = AST::GetID(x->lhs),
+        .LeftID = x->lhs->is_ident_or_scoperesol() ? AST::GetID(x->lhs) : nullptr,
     };
 
     ctx.ExprCtx = &exprC;
@@ -405,6 +538,11 @@ TypeInfo Sema::eval_type(ASTPointer ast, SemaContext Ctx) {
       throw Error(x->lhs, "expected writable expression");
     }
 
+    if (x->lhs->kind == ASTKind::IndexRef &&
+        this->eval_type(x->lhs->as_expr()->lhs).kind == TypeKind::String) {
+      throw Error(x->lhs, "cannot assign to character of string");
+    }
+
     if (exprC.AssignRightTypeToLVar) {
       debug(assert(exprC.TargetLVarPtr));
 
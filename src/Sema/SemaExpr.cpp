@@ -11,6 +11,44 @@ TypeInfo Sema::EvalExpr(ASTPtr<AST::Expr> ast) {
 
   bool is_same = lhs.equals(rhs);
 
+  //
+  // 固定幅整数 (i8 .. u64)
+  //   同じ型同士のみ。シフトの右辺は int も可
+  if (lhs.is_fixed_int()) {
+    switch (ast->kind) {
+    case Kind::Add:
+    case Kind::Sub:
+    case Kind::Mul:
+    case Kind::Div:
+    case Kind::Mod:
+    case Kind::BitAND:
+    case Kind::BitXOR:
+    case Kind::BitOR:
+      if (is_same)
+        return lhs;
+
+      break;
+
+    case Kind::LShift:
+    case Kind::RShift:
+      if (is_same || rhs.kind == TK::Int)
+        return lhs;
+
+      break;
+
+    case Kind::Bigger:
+    case Kind::BiggerOrEqual:
+    case Kind::Equal:
+      if (is_same)
+        return TK::Bool;
+
+      break;
+    }
+
+    throw Error(ast->op, "invalid operator '" + ast->op.str + "' for '" + lhs.to_string() +
+                             "' and '" + rhs.to_string() + "'");
+  }
+
   // 基本的な数値演算を除外
   switch (ast->kind) {
   case Kind::Add:
@@ -66,8 +104,11 @@ TypeInfo Sema::EvalExpr(ASTPtr<AST::Expr> ast) {
     // vector + T
     // T + vector
     //  --> append element to vector
-    if (lhs.kind == TK::Vector || rhs.kind == TK::Vector)
-      return TK::Vector;
+    if (lhs.kind == TK::Vector)
+      return lhs;
+
+    if (rhs.kind == TK::Vector)
+      return rhs;
 
     //
     // char + char  <--  Invalid
@@ -93,7 +134,7 @@ TypeInfo Sema::EvalExpr(ASTPtr<AST::Expr> ast) {
     //  => vector
     if (!is_same && lhs.is_hit_kind({TK::Int, TK::Vector}) &&
         rhs.is_hit_kind({TK::Int, TK::Vector}))
-      return TK::Vector;
+      return lhs.kind == TK::Vector ? lhs : rhs;
 
     break;
   }
@@ -80,11 +80,16 @@ IdentifierInfo Sema::GetIdentifierInfo(ASTPtr<AST::Identifier> Id, SemaContext&
       if (attr.name == name && LeftType.equals(attr.self_type)) {
         II.result.type = NameType::BuiltinMemberVar;
         II.result.builtin_attr = &attr;
+
+        Id->blt_member_var = &attr;
+        E->kind = ASTKind::BuiltinMemberVariable;
+
         break;
       }
     }
 
     // find built-in methods
+    //   (overloads are allowed; one of them is decided at call-expr.)
     for (auto const& [SelfType, M] : builtins::get_builtin_member_functions()) {
       if (SelfType.equals(LeftType) && M.name == name) {
         II.result.type = NameType::BuiltinMethod;
@@ -92,11 +97,8 @@ IdentifierInfo Sema::GetIdentifierInfo(ASTPtr<AST::Identifier> Id, SemaContext&
       }
     }
 
-    if (II.result.builtin_funcs.size() >= 2) {
-      //
-      // feature: overload of builtin func or methoda
-      //
-      todo_impl;
+    if (II.result.builtin_funcs.size() >= 1) {
+      E->kind = ASTKind::BuiltinMemberFunction;
     }
 
     return II;
@@ -329,30 +331,39 @@ SemaIdentifierEvalResult& Sema::EvalID(ASTPtr<AST::Identifier> id, SemaContext&
       id->candidates_builtin = std::move(res.builtin_funcs);
 
       if (id->candidates_builtin.size() >= 2) {
-        if (IsFuncNameCtxValid && Ctx.FuncNameCtx->MustDecideOneCandidate)
+        //
+        // overloaded builtin:
+        //   in call-expr, a candidate is decided by types of arguments.
+        if (!Ctx.InCallFunc() ||
+            (IsFuncNameCtxValid && Ctx.FuncNameCtx->MustDecideOneCandidate))
           throw Error(id->token, "function name '" + id->GetName() + "' is ambigous.");
-
-        todo_impl; // feature: overload of builtin func or method
       }
 
-      assert(id->candidates_builtin.size() == 1);
-
       auto func = id->candidates_builtin[0];
 
-      ST.is_free_args = func->is_variable_args;
-
-      ST.params = id->ft_args = func->arg_types;
-      ST.params.insert(ST.params.begin(), id->ft_ret = func->result_type);
+      id->ft_args = func->arg_types;
+      id->ft_ret = func->result_type;
 
       if (id->kind == ASTKind::BuiltinMemberFunction) {
         assert(Ctx.ExprCtx);
 
-        ST.params.insert(ST.params.begin() + 1, Ctx.ExprCtx->LeftType);
+        ST = this->make_functor_type(func, Ctx.ExprCtx->LeftType);
+      }
+      else {
+        ST = this->make_functor_type(func);
       }
 
       break;
     }
 
+    case NameType::BuiltinMemberVar: {
+      id->kind = ASTKind::BuiltinMemberVariable;
+
+      ST = res.builtin_attr->result_type;
+
+      break;
+    }
+
     case NameType::Class: {
       id->kind = ASTKind::ClassName;
       id->ast_class = res.ast_class;
@@ -84,13 +84,13 @@ BlockScope::BlockScope(int depth, ASTPtr<AST::Block> ast, int index_add)
     : ScopeContext(SC_Block),
       ast(ast) {
 
-  ast->ScopeCtxPtr = this;
-
   this->depth = depth;
 
   if (!ast)
     return;
 
+  ast->ScopeCtxPtr = this;
+
   for (auto&& e : ast->list) {
     switch (e->kind) {
     case ASTKind::Block: {
@@ -5,6 +5,7 @@
 #include "Sema/Sema.h"
 
 #include "Builtin.h"
+#include "BTree.h"
 
 #define printkind alertmsg(static_cast<int>(ast->kind))
 #define printkind_of(_A) alertmsg(static_cast<int>((_A)->kind))
@@ -43,6 +44,28 @@ TypeInfo Sema::eval_type_name(ASTPtr<AST::TypeName> ast) {
       throw Error(ast->token, "too many template arguments");
     }
 
+    if (type.kind == TypeKind::Dict && !ObjDict::IsHashableType(type.params[0])) {
+      throw Error(ast->type_params[0], "'" + type.params[0].to_string() +
+                                           "' type cannot be used as key of dict");
+    }
+
+    if (type.kind == TypeKind::Set && !ObjDict::IsHashableType(type.params[0])) {
+      throw Error(ast->type_params[0], "'" + type.params[0].to_string() +
+                                           "' type cannot be used as element of set");
+    }
+
+    if (type.kind == TypeKind::OrderedMap &&
+        !btree::BTree::IsOrderedType(type.params[0].kind)) {
+      throw Error(ast->type_params[0], "'" + type.params[0].to_string() +
+                                           "' type cannot be used as key of ordered_map");
+    }
+
+    if (type.kind == TypeKind::PriorityQueue &&
+        !btree::BTree::IsOrderedType(type.params[0].kind)) {
+      throw Error(ast->type_params[0], "'" + type.params[0].to_string() +
+                                           "' type cannot be used as element of priority_queue");
+    }
+
     return type;
   }
   }
@@ -508,12 +531,78 @@ TypeInfo Sema::make_functor_type(ASTPtr<AST::Function> ast) {
 TypeInfo Sema::make_functor_type(builtins::Function const* builtin) {
   TypeInfo ret = TypeKind::Function;
 
+  ret.is_free_args = builtin->is_variable_args;
+
   ret.params = builtin->arg_types;
   ret.params.insert(ret.params.begin(), builtin->result_type);
 
   return ret;
 }
 
+//
+// functor type of builtin method.
+//   params[0] = result, params[1] = self, params[>=2] = args
+//
+TypeInfo Sema::make_functor_type(builtins::Function const* builtin,
+                                 TypeInfo const& self) {
+  TypeInfo ret = this->make_functor_type(builtin);
+
+  for (auto&& t : ret.params)
+    t = this->ResolveBuiltinTemplateType(t, builtin, self);
+
+  ret.params.insert(ret.params.begin() + 1, self);
+
+  ret.is_member_func = true;
+
+  return ret;
+}
+
+//
+// ResolveBuiltinTemplateType:
+//
+// 組み込みメソッドの self 型に名前付きの Unknown 型 (テンプレートパラメータ) が
+// 含まれている場合，それを実際の self 型の対応するパラメータに置き換えます．
+//
+//   e.g.  self = vector<T>,  push(T)
+//         --> called with vector<int>  ==>  push(int)
+//
+TypeInfo Sema::ResolveBuiltinTemplateType(TypeInfo const& type,
+                                          builtins::Function const* builtin,
+                                          TypeInfo const& self) {
+  TypeInfo const* SelfType = nullptr;
+
+  for (auto const& [T, M] : builtins::get_builtin_member_functions()) {
+    if (&M == builtin) {
+      SelfType = &T;
+      break;
+    }
+  }
+
+  if (!SelfType)
+    return type;
+
+  std::function<TypeInfo(TypeInfo const&)> resolve =
+      [&](TypeInfo const& t) -> TypeInfo {
+    if (t.kind == TypeKind::Unknown && !t.name.empty()) {
+      for (size_t i = 0; i < SelfType->params.size() && i < self.params.size(); i++) {
+        if (SelfType->params[i].name == t.name)
+          return self.params[i];
+      }
+
+      return t;
+    }
+
+    auto ret = t;
+
+    for (auto&& p : ret.params)
+      p = resolve(p);
+
+    return ret;
+  };
+
+  return resolve(type);
+}
+
 bool Sema::IsDerivedFrom(ASTPtr<AST::Class> _class, ASTPtr<AST::Class> _base) {
 
   for (auto C = _class->InheritBaseClassPtr; C; C = C->InheritBaseClassPtr) {
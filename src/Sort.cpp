@@ -0,0 +1,180 @@
+#include <cstring>
+#include <thread>
+
+#include "Object.h"
+#include "Sort.h"
+
+namespace fire::sort {
+
+//
+// arrays smaller than this are sorted by one thread.
+//
+static constexpr size_t parallel_threshold = 1 << 17;
+
+//
+// sort chunks by threads, then merge them in pairs, in parallel.
+//   seq(begin, count) sorts a chunk. merge is stable.
+//
+template <typename T, typename SeqSort, typename Less>
+static void parallel_sort(T* a, size_t n, SeqSort seq, Less less) {
+  size_t threads = std::thread::hardware_concurrency();
+
+  if (n < parallel_threshold || threads < 2) {
+    seq(a, n);
+    return;
+  }
+
+  // count of chunks is power of 2; each chunk has at least threshold / 2 elements
+  size_t chunks = 1;
+
+  while (chunks * 2 <= threads && n / (chunks * 2) >= parallel_threshold / 2)
+    chunks *= 2;
+
+  Vec<size_t> bounds(chunks + 1);
+
+  for (size_t i = 0; i <= chunks; i++)
+    bounds[i] = n * i / chunks;
+
+  {
+    Vec<std::thread> workers;
+
+    for (size_t i = 0; i < chunks; i++)
+      workers.emplace_back([&, i] { seq(a + bounds[i], bounds[i + 1] - bounds[i]); });
+
+    for (auto& w : workers)
+      w.join();
+  }
+
+  Vec<T> buf(n);
+
+  T* src = a;
+  T* dst = buf.data();
+
+  for (size_t width = 1; width < chunks; width *= 2) {
+    Vec<std::thread> workers;
+
+    for (size_t i = 0; i < chunks; i += width * 2) {
+      workers.emplace_back([&, i, width] {
+        auto begin = bounds[i];
+        auto mid = bounds[i + width];
+        auto end = bounds[i + width * 2];
+
+        std::merge(std::make_move_iterator(src + begin), std::make_move_iterator(src + mid),
+                   std::make_move_iterator(src + mid), std::make_move_iterator(src + end),
+                   dst + begin, less);
+      });
+    }
+
+    for (auto& w : workers)
+      w.join();
+
+    std::swap(src, dst);
+  }
+
+  if (src != a)
+    std::move(src, src + n, a);
+}
+
+//
+// LSD radix sort by 8-bit digits.
+//   key(x) is an unsigned integer which is ordered same as x.
+//   digits which are same in all elements are skipped.
+//
+template <typename T, typename Key>
+static void radix_sort(T* a, size_t n, Key key) {
+  using K = decltype(key(*a));
+
+  constexpr size_t digits = sizeof(K);
+
+  if (n < 64) {
+    PdqSort(a, a + n, [&key](T x, T y) { return key(x) < key(y); });
+    return;
+  }
+
+  size_t count[digits][256] = {};
+
+  for (size_t i = 0; i < n; i++) {
+    auto k = key(a[i]);
+
+    for (size_t d = 0; d < digits; d++)
+      count[d][(k >> (d * 8)) & 0xff]++;
+  }
+
+  Vec<T> buf(n);
+
+  T* src = a;
+  T* dst = buf.data();
+
+  for (size_t d = 0; d < digits; d++) {
+    auto& c = count[d];
+
+    // all elements have same digit
+    if (c[(key(a[0]) >> (d * 8)) & 0xff] == n)
+      continue;
+
+    size_t offset[256];
+    size_t sum = 0;
+
+    for (size_t b = 0; b < 256; b++) {
+      offset[b] = sum;
+      sum += c[b];
+    }
+
+    for (size_t i = 0; i < n; i++)
+      dst[offset[(key(src[i]) >> (d * 8)) & 0xff]++] = src[i];
+
+    std::swap(src, dst);
+  }
+
+  if (src != a)
+    std::memcpy(a, src, n * sizeof(T));
+}
+
+static u64 int_key(i64 x) {
+  return (u64)x ^ (u64(1) << 63);
+}
+
+//
+// bits of float, ordered as number:
+//   negative: all bits are flipped,  positive: sign bit is set.
+//   (-0 < +0, and nan are at both ends)
+//
+static u64 float_key(double x) {
+  u64 bits;
+
+  std::memcpy(&bits, &x, sizeof(bits));
+
+  return (bits >> 63) ? ~bits : bits | (u64(1) << 63);
+}
+
+void Sort(i64* a, size_t n) {
+  parallel_sort(
+      a, n, [](i64* p, size_t m) { radix_sort(p, m, int_key); },
+      [](i64 x, i64 y) { return x < y; });
+}
+
+void Sort(double* a, size_t n) {
+  parallel_sort(
+      a, n, [](double* p, size_t m) { radix_sort(p, m, float_key); },
+      [](double x, double y) { return float_key(x) < float_key(y); });
+}
+
+void Sort(char16_t* a, size_t n) {
+  PdqSort(a, a + n, [](char16_t x, char16_t y) { return x < y; });
+}
+
+void SortStrings(ObjPointer* a, size_t n, bool stable) {
+  auto less = [](ObjPointer const& x, ObjPointer const& y) {
+    return x->As<ObjString>()->View() < y->As<ObjString>()->View();
+  };
+
+  if (stable)
+    parallel_sort(
+        a, n, [&less](ObjPointer* p, size_t m) { std::stable_sort(p, p + m, less); },
+        less);
+  else
+    parallel_sort(
+        a, n, [&less](ObjPointer* p, size_t m) { PdqSort(p, p + m, less); }, less);
+}
+
+} // namespace fire::sort
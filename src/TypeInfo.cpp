@@ -15,13 +15,31 @@ static char const* g_names[] = {
   "int",
   "float",
   "bool",
+
+  "i8",
+  "i16",
+  "i32",
+  "u8",
+  "u16",
+  "u32",
+  "u64",
   
   "char",
   "string",
+  "StringBuilder",
+  "regex",
+  "LineReader",
   
   "vector",
   "tuple",
   "dict",
+  "ordered_map",
+  "set",
+  "bitset",
+  "deque",
+  "priority_queue",
+  "matrix",
+  "bytes",
 
   "", // Enumerator
   "", // Instance
@@ -40,11 +58,28 @@ static std::map<TypeKind, char const*> kind_name_map {
   { TypeKind::Int,        "int" },
   { TypeKind::Float,      "float" },
   { TypeKind::Bool,       "bool" },
+  { TypeKind::I8,         "i8" },
+  { TypeKind::I16,        "i16" },
+  { TypeKind::I32,        "i32" },
+  { TypeKind::U8,         "u8" },
+  { TypeKind::U16,        "u16" },
+  { TypeKind::U32,        "u32" },
+  { TypeKind::U64,        "u64" },
   { TypeKind::Char,       "char" },
   { TypeKind::String,     "string" },
+  { TypeKind::StringBuilder, "StringBuilder" },
+  { TypeKind::Regex,      "regex" },
+  { TypeKind::LineReader, "LineReader" },
   { TypeKind::Vector,     "vector" },
   { TypeKind::Tuple,      "tuple" },
   { TypeKind::Dict,       "dict" },
+  { TypeKind::OrderedMap, "ordered_map" },
+  { TypeKind::Set,        "set" },
+  { TypeKind::BitSet,     "bitset" },
+  { TypeKind::Deque,      "deque" },
+  { TypeKind::PriorityQueue, "priority_queue" },
+  { TypeKind::Matrix,     "matrix" },
+  { TypeKind::Bytes,      "bytes" },
   { TypeKind::Instance,   "instance" },
   { TypeKind::Module,     "module" },
   { TypeKind::Function,   "function" },
@@ -138,7 +173,7 @@ bool TypeInfo::equals(TypeInfo const& type) const {
   }
 
   for (auto it = this->params.begin(); auto&& t : type.params)
-    if (!it->equals(t))
+    if (!(it++)->equals(t))
       return false;
 
   return true;
@@ -221,6 +256,9 @@ TypeInfo TypeInfo::without_params() const {
 int TypeInfo::needed_param_count() const {
   switch (this->kind) {
   case TypeKind::Vector:
+  case TypeKind::Set:
+  case TypeKind::Deque:
+  case TypeKind::PriorityQueue:
     return 1;
 
   case TypeKind::Function:
@@ -228,6 +266,7 @@ int TypeInfo::needed_param_count() const {
     return -1;
 
   case TypeKind::Dict:
+  case TypeKind::OrderedMap:
     return 2; // key, value
 
   case TypeKind::TypeName: {
@@ -278,6 +317,14 @@ TypeInfo TypeInfo::make_instance_type(ASTPtr<AST::Class> ast) {
   return ret;
 }
 
+TypeInfo TypeInfo::make_template_param(string const& name) {
+  TypeInfo t = TypeKind::Unknown;
+
+  t.name = name;
+
+  return t;
+}
+
 TypeKind TypeInfo::from_name(string const& name) {
   for (int i = 0; auto& s : g_names) {
     if (s == name)
@@ -1,11 +1,9 @@
+#include <cstring>
+
 #include "Utils.h"
 
 namespace utils {
 
-static std::wstring_convert<std::codecvt_utf8_utf16<char16_t>,
-                            char16_t>
-    conv;
-
 std::string remove_color(std::string str) {
   size_t pos = 0;
 
@@ -29,12 +27,215 @@ i64 get_color_length_in_str(std::string const& str) {
   return str.length() - get_length_without_color(str);
 }
 
-std::string to_u8string(std::u16string const& str) {
-  return conv.to_bytes(str);
+static constexpr char32_t replacement_char = 0xFFFD;
+
+//
+// write UTF-8 encoding of str to dest.
+// dest must have space of (str.length() * 3) bytes at least.
+//
+static char* encode_u8(char* dest, std::u16string_view str) {
+  char16_t const* src = str.data();
+  size_t const len = str.length();
+
+  for (size_t i = 0; i < len;) {
+    //
+    // ASCII: 4 code units at once
+    if (u64 w; i + 4 <= len) {
+      std::memcpy(&w, src + i, sizeof(w));
+
+      if ((w & 0xFF80FF80FF80FF80) == 0) {
+        for (int k = 0; k < 4; k++)
+          *dest++ = static_cast<char>(src[i + k]);
+
+        i += 4;
+        continue;
+      }
+    }
+
+    char32_t c = src[i++];
+
+    if (c < 0x80) {
+      *dest++ = static_cast<char>(c);
+      continue;
+    }
+
+    if (c < 0x800) {
+      *dest++ = static_cast<char>(0xC0 | (c >> 6));
+      *dest++ = static_cast<char>(0x80 | (c & 0x3F));
+      continue;
+    }
+
+    if (0xD800 <= c && c <= 0xDFFF) {
+      // surrogate pair
+      if (c <= 0xDBFF && i < len && 0xDC00 <= src[i] && src[i] <= 0xDFFF) {
+        c = 0x10000 + ((c - 0xD800) << 10) + (src[i++] - 0xDC00);
+
+        *dest++ = static_cast<char>(0xF0 | (c >> 18));
+        *dest++ = static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+        *dest++ = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+        *dest++ = static_cast<char>(0x80 | (c & 0x3F));
+        continue;
+      }
+
+      c = replacement_char;
+    }
+
+    *dest++ = static_cast<char>(0xE0 | (c >> 12));
+    *dest++ = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+    *dest++ = static_cast<char>(0x80 | (c & 0x3F));
+  }
+
+  return dest;
 }
 
-std::u16string to_u16string(std::string const& str) {
-  return conv.from_bytes(str);
+std::string to_u8string(std::u16string_view str) {
+  std::string ret;
+
+  append_u8string(ret, str);
+
+  return ret;
+}
+
+void append_u8string(std::string& out, std::u16string_view str) {
+  size_t const pos = out.length();
+
+  out.resize(pos + str.length() * 3);
+
+  out.resize(encode_u8(out.data() + pos, str) - out.data());
+}
+
+std::u16string to_u16string(std::string_view str) {
+  std::u16string ret;
+
+  // count of UTF-16 code units is not bigger than bytes.
+  ret.resize(str.length());
+
+  auto src = reinterpret_cast<unsigned char const*>(str.data());
+  size_t const len = str.length();
+
+  char16_t* dest = ret.data();
+
+  for (size_t i = 0; i < len;) {
+    //
+    // ASCII: 8 bytes at once
+    if (u64 w; i + 8 <= len) {
+      std::memcpy(&w, src + i, sizeof(w));
+
+      if ((w & 0x8080808080808080) == 0) {
+        for (int k = 0; k < 8; k++)
+          *dest++ = src[i + k];
+
+        i += 8;
+        continue;
+      }
+    }
+
+    char32_t c = src[i];
+
+    if (c < 0x80) {
+      *dest++ = static_cast<char16_t>(c);
+      i++;
+      continue;
+    }
+
+    // length of sequence, and minimum value (reject overlong)
+    size_t n = 0;
+    char32_t min = 0;
+
+    if ((c & 0xE0) == 0xC0)
+      n = 2, min = 0x80, c &= 0x1F;
+    else if ((c & 0xF0) == 0xE0)
+      n = 3, min = 0x800, c &= 0x0F;
+    else if ((c & 0xF8) == 0xF0)
+      n = 4, min = 0x10000, c &= 0x07;
+
+    bool valid = n != 0 && i + n <= len;
+
+    for (size_t k = 1; valid && k < n; k++) {
+      if ((src[i + k] & 0xC0) != 0x80)
+        valid = false;
+      else
+        c = (c << 6) | (src[i + k] & 0x3F);
+    }
+
+    if (!valid || c < min || c > 0x10FFFF || (0xD800 <= c && c <= 0xDFFF)) {
+      *dest++ = replacement_char;
+      i++;
+      continue;
+    }
+
+    i += n;
+
+    if (c >= 0x10000) {
+      c -= 0x10000;
+      *dest++ = static_cast<char16_t>(0xD800 + (c >> 10));
+      *dest++ = static_cast<char16_t>(0xDC00 + (c & 0x3FF));
+    }
+    else {
+      *dest++ = static_cast<char16_t>(c);
+    }
+  }
+
+  ret.resize(dest - ret.data());
+
+  return ret;
+}
+
+size_t find_u16(std::u16string_view str, char16_t c, size_t pos) {
+  char16_t const* src = str.data();
+  size_t const len = str.length();
+
+  constexpr u64 lo = 0x0001000100010001;
+  constexpr u64 hi = 0x8000800080008000;
+
+  u64 const pattern = lo * c;
+
+  //
+  // 4 code units at once:
+  //   lanes equal to c become zero, and a zero lane is detected
+  //   by bit trick. (same as memchr)
+  for (; pos + 4 <= len; pos += 4) {
+    u64 w;
+    std::memcpy(&w, src + pos, sizeof(w));
+
+    w ^= pattern;
+
+    if (((w - lo) & ~w & hi) != 0)
+      break;
+  }
+
+  for (; pos < len; pos++)
+    if (src[pos] == c)
+      return pos;
+
+  return std::u16string_view::npos;
+}
+
+size_t find_u16(std::u16string_view str, std::u16string_view s, size_t pos) {
+  size_t const len = str.length();
+  size_t const n = s.length();
+
+  if (n == 0)
+    return pos <= len ? pos : std::u16string_view::npos;
+
+  if (n == 1)
+    return find_u16(str, s[0], pos);
+
+  //
+  // find candidates by first code unit, then compare the rest.
+  while (pos + n <= len) {
+    pos = find_u16(str.substr(0, len - n + 1), s[0], pos);
+
+    if (pos == std::u16string_view::npos)
+      break;
+
+    if (std::memcmp(str.data() + pos + 1, s.data() + 1, (n - 1) * sizeof(char16_t)) == 0)
+      return pos;
+
+    pos++;
+  }
+
+  return std::u16string_view::npos;
 }
 
 std::string get_base_name(std::string path) {